@@ -0,0 +1,159 @@
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // Reference ring using the previous indexing scheme: a full_ flag and a
+    // % Size on every step, kept to measure the wrap strategies against it
+    template <typename T, std::size_t Size>
+    class ModuloRing
+    {
+    private:
+        T buffer_[Size];
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+        bool full_ = false;
+
+    public:
+        std::size_t size() const
+        {
+            if (full_)
+            {
+                return Size;
+            }
+            return (head_ >= tail_) ? (head_ - tail_) : (Size - tail_ + head_);
+        }
+
+        bool empty() const
+        {
+            return !full_ && head_ == tail_;
+        }
+
+        void push_back(const T &item)
+        {
+            bool isEmpty = empty();
+            buffer_[head_] = item;
+            head_ = (head_ + 1) % Size;
+            if (!isEmpty && head_ == tail_ % Size)
+            {
+                full_ = true;
+            }
+            else if (!isEmpty && head_ == (tail_ + 1) % Size)
+            {
+                tail_ = (tail_ + 1) % Size;
+            }
+        }
+
+        void pop_front()
+        {
+            if (!empty())
+            {
+                tail_ = (tail_ + 1) % Size;
+                full_ = false;
+            }
+        }
+
+        const T &operator[](std::size_t index) const
+        {
+            return buffer_[(tail_ + index) % Size];
+        }
+    };
+} // namespace
+
+template <typename Ring>
+static void BM_PushBackOverwrite(benchmark::State &state)
+{
+    Ring ring;
+    int value = 0;
+    for (auto _ : state)
+    {
+        ring.push_back(value++);
+        benchmark::DoNotOptimize(ring);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Ring>
+static void BM_PushPop(benchmark::State &state)
+{
+    Ring ring;
+    int value = 0;
+    for (auto _ : state)
+    {
+        ring.push_back(value++);
+        ring.push_back(value++);
+        ring.pop_front();
+        benchmark::DoNotOptimize(ring);
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+
+template <typename Ring>
+static void BM_IndexScan(benchmark::State &state)
+{
+    Ring ring;
+    for (int i = 0; i < 1500; ++i)
+    {
+        ring.push_back(i);
+    }
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            sum += ring[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ring.size());
+}
+
+static void BM_PushBackBlockPerElement(benchmark::State &state)
+{
+    CircularBuffer<float, 16384> ring;
+    std::vector<float> block(static_cast<std::size_t>(state.range(0)), 1.0f);
+    for (auto _ : state)
+    {
+        for (float sample : block)
+        {
+            ring.push_back(sample);
+        }
+        benchmark::DoNotOptimize(ring);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PushBackBlockBulk(benchmark::State &state)
+{
+    CircularBuffer<float, 16384> ring;
+    std::vector<float> block(static_cast<std::size_t>(state.range(0)), 1.0f);
+    for (auto _ : state)
+    {
+        ring.push_back(block);
+        benchmark::DoNotOptimize(ring);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, CircularBuffer<int, 1024>);
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, CircularBuffer<int, 1000>);
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, ModuloRing<int, 1024>);
+BENCHMARK_TEMPLATE(BM_PushBackOverwrite, ModuloRing<int, 1000>);
+
+BENCHMARK_TEMPLATE(BM_PushPop, CircularBuffer<int, 1024>);
+BENCHMARK_TEMPLATE(BM_PushPop, CircularBuffer<int, 1000>);
+BENCHMARK_TEMPLATE(BM_PushPop, ModuloRing<int, 1024>);
+BENCHMARK_TEMPLATE(BM_PushPop, ModuloRing<int, 1000>);
+
+BENCHMARK_TEMPLATE(BM_IndexScan, CircularBuffer<int, 1024>);
+BENCHMARK_TEMPLATE(BM_IndexScan, CircularBuffer<int, 1000>);
+BENCHMARK_TEMPLATE(BM_IndexScan, ModuloRing<int, 1024>);
+BENCHMARK_TEMPLATE(BM_IndexScan, ModuloRing<int, 1000>);
+
+BENCHMARK(BM_PushBackBlockPerElement)->Arg(256)->Arg(4096);
+BENCHMARK(BM_PushBackBlockBulk)->Arg(256)->Arg(4096);
@@ -0,0 +1,202 @@
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(CXXCIRCULARBUFFER_HAVE_BOOST)
+#include <boost/circular_buffer.hpp>
+#endif
+
+using namespace CXXCircularBuffer;
+
+// Every container is driven through the same bounded-ring interface: a push
+// into a full ring drops the oldest element, as CircularBuffer::push_back does
+namespace
+{
+    template <typename T, std::size_t Size>
+    struct FixedRing
+    {
+        CircularBuffer<T, Size> ring;
+
+        void push(const T &value) { ring.push_back(value); }
+        void pop() { ring.pop_front(); }
+        std::size_t size() const { return ring.size(); }
+        const T &operator[](std::size_t index) const { return ring[index]; }
+        auto begin() const { return ring.begin(); }
+        auto end() const { return ring.end(); }
+    };
+
+    template <typename T, std::size_t Size>
+    struct DequeRing
+    {
+        std::deque<T> ring;
+
+        void push(const T &value)
+        {
+            if (ring.size() == Size)
+            {
+                ring.pop_front();
+            }
+            ring.push_back(value);
+        }
+        void pop() { ring.pop_front(); }
+        std::size_t size() const { return ring.size(); }
+        const T &operator[](std::size_t index) const { return ring[index]; }
+        auto begin() const { return ring.begin(); }
+        auto end() const { return ring.end(); }
+    };
+
+#if defined(CXXCIRCULARBUFFER_HAVE_BOOST)
+    template <typename T, std::size_t Size>
+    struct BoostRing
+    {
+        boost::circular_buffer<T> ring{Size};
+
+        void push(const T &value) { ring.push_back(value); }
+        void pop() { ring.pop_front(); }
+        std::size_t size() const { return ring.size(); }
+        const T &operator[](std::size_t index) const { return ring[index]; }
+        auto begin() const { return ring.begin(); }
+        auto end() const { return ring.end(); }
+    };
+#endif
+
+    template <typename T>
+    T make_value(std::size_t i);
+
+    template <>
+    int make_value<int>(std::size_t i)
+    {
+        return static_cast<int>(i);
+    }
+
+    template <>
+    double make_value<double>(std::size_t i)
+    {
+        return static_cast<double>(i) * 0.5;
+    }
+
+    // Long enough to defeat the small string optimization
+    template <>
+    std::string make_value<std::string>(std::size_t i)
+    {
+        return std::string(48, static_cast<char>('a' + i % 26));
+    }
+
+    template <typename Ring>
+    void fill(Ring &ring, std::size_t count)
+    {
+        typedef typename std::decay<decltype(ring[0])>::type value_type;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ring.push(make_value<value_type>(i));
+        }
+    }
+} // namespace
+
+// Steady state of a half-full ring: one push and one pop per iteration
+template <typename Ring, typename T, std::size_t Size>
+static void BM_PushPopThroughput(benchmark::State &state)
+{
+    Ring ring;
+    fill(ring, Size / 2);
+    const T value = make_value<T>(7);
+    for (auto _ : state)
+    {
+        ring.push(value);
+        ring.pop();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Every push lands in a full ring and evicts the oldest element
+template <typename Ring, typename T, std::size_t Size>
+static void BM_OverwriteHeavy(benchmark::State &state)
+{
+    Ring ring;
+    fill(ring, Size);
+    const T value = make_value<T>(11);
+    for (auto _ : state)
+    {
+        ring.push(value);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Ring, typename T, std::size_t Size>
+static void BM_Iterate(benchmark::State &state)
+{
+    Ring ring;
+    // Overfill so that the content wraps around the end of the storage
+    fill(ring, Size + Size / 3);
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (const auto &item : ring)
+        {
+            benchmark::DoNotOptimize(item);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * ring.size());
+}
+
+template <typename Ring, typename T, std::size_t Size>
+static void BM_RandomAccess(benchmark::State &state)
+{
+    Ring ring;
+    fill(ring, Size + Size / 3);
+    std::vector<std::size_t> indices(4096);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> distribution(0, ring.size() - 1);
+    for (auto &index : indices)
+    {
+        index = distribution(generator);
+    }
+    for (auto _ : state)
+    {
+        for (std::size_t index : indices)
+        {
+            benchmark::DoNotOptimize(ring[index]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+
+#define CXXCB_BENCHMARK_RINGS(Benchmark, T, Size)                        \
+    BENCHMARK_TEMPLATE(Benchmark, FixedRing<T, Size>, T, Size);          \
+    BENCHMARK_TEMPLATE(Benchmark, DequeRing<T, Size>, T, Size);          \
+    CXXCB_BENCHMARK_BOOST_RING(Benchmark, T, Size)
+
+#if defined(CXXCIRCULARBUFFER_HAVE_BOOST)
+#define CXXCB_BENCHMARK_BOOST_RING(Benchmark, T, Size) \
+    BENCHMARK_TEMPLATE(Benchmark, BoostRing<T, Size>, T, Size);
+#else
+#define CXXCB_BENCHMARK_BOOST_RING(Benchmark, T, Size)
+#endif
+
+#define CXXCB_BENCHMARK_SIZES(Benchmark, T)   \
+    CXXCB_BENCHMARK_RINGS(Benchmark, T, 64)   \
+    CXXCB_BENCHMARK_RINGS(Benchmark, T, 1000) \
+    CXXCB_BENCHMARK_RINGS(Benchmark, T, 4096) \
+    CXXCB_BENCHMARK_RINGS(Benchmark, T, 65536)
+
+CXXCB_BENCHMARK_SIZES(BM_PushPopThroughput, int)
+CXXCB_BENCHMARK_SIZES(BM_PushPopThroughput, double)
+CXXCB_BENCHMARK_RINGS(BM_PushPopThroughput, std::string, 1024)
+
+CXXCB_BENCHMARK_SIZES(BM_OverwriteHeavy, int)
+CXXCB_BENCHMARK_RINGS(BM_OverwriteHeavy, std::string, 1024)
+
+CXXCB_BENCHMARK_SIZES(BM_Iterate, int)
+CXXCB_BENCHMARK_RINGS(BM_Iterate, std::string, 1024)
+
+CXXCB_BENCHMARK_SIZES(BM_RandomAccess, int)
+CXXCB_BENCHMARK_RINGS(BM_RandomAccess, std::string, 1024)
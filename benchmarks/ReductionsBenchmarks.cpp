@@ -0,0 +1,74 @@
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <CXXCircularBuffer/Reductions.hpp>
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    typedef CircularBuffer<float, 65536> Window;
+
+    // Heap allocated: the window is too large for the benchmark thread's stack
+    std::unique_ptr<Window> make_window()
+    {
+        auto window = std::make_unique<Window>();
+        for (int i = 0; i < 65536 + 12345; ++i)
+        {
+            window->push_back(static_cast<float>(i % 97) * 0.25f);
+        }
+        return window;
+    }
+} // namespace
+
+static void BM_WindowSumIterator(benchmark::State &state)
+{
+    auto window = make_window();
+    for (auto _ : state)
+    {
+        float total = 0;
+        for (float value : *window)
+        {
+            total += value;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * window->size() * sizeof(float));
+}
+
+static void BM_WindowSum(benchmark::State &state)
+{
+    auto window = make_window();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sum(*window));
+    }
+    state.SetBytesProcessed(state.iterations() * window->size() * sizeof(float));
+}
+
+static void BM_WindowVariance(benchmark::State &state)
+{
+    auto window = make_window();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(variance(*window));
+    }
+    state.SetBytesProcessed(state.iterations() * window->size() * sizeof(float) * 2);
+}
+
+static void BM_WindowMinMax(benchmark::State &state)
+{
+    auto window = make_window();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(minimum(*window));
+        benchmark::DoNotOptimize(maximum(*window));
+    }
+    state.SetBytesProcessed(state.iterations() * window->size() * sizeof(float) * 2);
+}
+
+BENCHMARK(BM_WindowSumIterator);
+BENCHMARK(BM_WindowSum);
+BENCHMARK(BM_WindowVariance);
+BENCHMARK(BM_WindowMinMax);
@@ -0,0 +1,137 @@
+#ifndef CXXCIRCULARBUFFER_ALGORITHMS_HPP
+#define CXXCIRCULARBUFFER_ALGORITHMS_HPP
+
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+// Segmented versions of common algorithms for any buffer exposing
+// array_one()/array_two() and begin(). Each one runs the standard algorithm
+// over the (at most two) contiguous segments, so the inner loops work on
+// plain pointers: no wrap check per element, and copies of trivially
+// copyable elements become memmove.
+namespace CXXCircularBuffer
+{
+
+    // Calls f with each non-empty contiguous run of the buffer, oldest first,
+    // as a Span; the elements are mutable when the buffer is. Returns f.
+    template <typename Buffer, typename Function, typename = decltype(std::declval<Buffer &>().array_one())>
+    Function for_each_segment(Buffer &buffer, Function f)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        if (!one.empty())
+        {
+            f(one);
+        }
+        if (!two.empty())
+        {
+            f(two);
+        }
+        return f;
+    }
+
+    // The same over the Segments returned by peek() and reserve()
+    template <typename T, typename Function>
+    Function for_each_segment(const Segments<T> &segments, Function f)
+    {
+        if (!segments.one.empty())
+        {
+            f(segments.one);
+        }
+        if (!segments.two.empty())
+        {
+            f(segments.two);
+        }
+        return f;
+    }
+
+    // Copies the elements, oldest first, to out and returns the end of the
+    // output
+    template <typename Buffer, typename OutputIt>
+    OutputIt copy(const Buffer &buffer, OutputIt out)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return std::copy(two.begin(), two.end(), std::copy(one.begin(), one.end(), out));
+    }
+
+    // Writes op(element) for each element, oldest first, to out and returns
+    // the end of the output
+    template <typename Buffer, typename OutputIt, typename UnaryOperation>
+    OutputIt transform(const Buffer &buffer, OutputIt out, UnaryOperation op)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return std::transform(two.begin(), two.end(), std::transform(one.begin(), one.end(), out, op), op);
+    }
+
+    template <typename Buffer, typename T, typename BinaryOperation>
+    T accumulate(const Buffer &buffer, T init, BinaryOperation op)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return std::accumulate(two.begin(), two.end(), std::accumulate(one.begin(), one.end(), std::move(init), op),
+                               op);
+    }
+
+    template <typename Buffer, typename T>
+    T accumulate(const Buffer &buffer, T init)
+    {
+        return CXXCircularBuffer::accumulate(buffer, std::move(init), std::plus<>());
+    }
+
+    template <typename Buffer, typename T>
+    std::size_t count(const Buffer &buffer, const T &value)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return static_cast<std::size_t>(std::count(one.begin(), one.end(), value) +
+                                        std::count(two.begin(), two.end(), value));
+    }
+
+    // Iterator to the oldest element equal to value, or end()
+    template <typename Buffer, typename T>
+    typename Buffer::const_iterator find(const Buffer &buffer, const T &value)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        const auto in_one = std::find(one.begin(), one.end(), value);
+        if (in_one != one.end())
+        {
+            return buffer.begin() + (in_one - one.begin());
+        }
+        const auto in_two = std::find(two.begin(), two.end(), value);
+        return buffer.begin() + static_cast<std::ptrdiff_t>(one.size()) + (in_two - two.begin());
+    }
+
+    // Iterator to the first element not ordered before value by comp, or
+    // end(). The buffer must be sorted by comp from oldest to newest, as a
+    // stream of timestamps is.
+    template <typename Buffer, typename T, typename Compare>
+    typename Buffer::const_iterator lower_bound(const Buffer &buffer, const T &value, Compare comp)
+    {
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        // Only one segment can hold the bound: the second when the whole
+        // first one orders before value
+        if (one.empty() || comp(one.back(), value))
+        {
+            const auto bound = std::lower_bound(two.begin(), two.end(), value, comp);
+            return buffer.begin() + static_cast<std::ptrdiff_t>(one.size()) + (bound - two.begin());
+        }
+        return buffer.begin() + (std::lower_bound(one.begin(), one.end(), value, comp) - one.begin());
+    }
+
+    template <typename Buffer, typename T>
+    typename Buffer::const_iterator lower_bound(const Buffer &buffer, const T &value)
+    {
+        return CXXCircularBuffer::lower_bound(buffer, value, std::less<>());
+    }
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_ALGORITHMS_HPP
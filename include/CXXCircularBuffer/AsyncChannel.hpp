@@ -0,0 +1,400 @@
+#ifndef CXXCIRCULARBUFFER_ASYNCCHANNEL_HPP
+#define CXXCIRCULARBUFFER_ASYNCCHANNEL_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    // Minimal scheduler for AsyncChannel: post() queues a coroutine, and run()
+    // resumes the queued coroutines on the calling thread, including those
+    // queued meanwhile, until none is left. post() may be called from any
+    // thread.
+    class ReadyQueue
+    {
+    private:
+        std::mutex mutex_;
+        std::deque<std::coroutine_handle<>> ready_;
+
+    public:
+        void post(std::coroutine_handle<> handle)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(handle);
+        }
+
+        // Returns how many coroutines were resumed
+        size_t run()
+        {
+            size_t resumed = 0;
+            for (;;)
+            {
+                std::coroutine_handle<> handle;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (ready_.empty())
+                    {
+                        return resumed;
+                    }
+                    handle = ready_.front();
+                    ready_.pop_front();
+                }
+                handle.resume();
+                ++resumed;
+            }
+        }
+    };
+
+    // Bounded channel between coroutines (C++20), built on a CircularBuffer of
+    // Size elements:
+    //
+    //     co_await channel.push(item);                       // false once closed
+    //     std::optional<T> item = co_await channel.pop();    // empty once closed and drained
+    //
+    // A push into a full channel or a pop from an empty one suspends the
+    // coroutine instead of blocking its thread; the opposite side wakes it,
+    // handing the element over without a second copy through the ring.
+    // Suspended awaiters are queued in FIFO order, linked through the awaiters
+    // themselves, so waiting allocates nothing.
+    //
+    // A waiter is never resumed inside the call that wakes it: push, pop,
+    // try_push(), try_pop() and close() post the waiters they wake to the
+    // scheduler and return, so a long chain of coroutines linked by channels
+    // does not nest on the stack, and each one runs wherever the scheduler
+    // runs it rather than on the thread of its neighbour. Scheduler needs a
+    // thread-safe post(std::coroutine_handle<>) that resumes the handle
+    // later, never inline, such as ReadyQueue or a thread pool's.
+    //
+    // Any number of coroutines, on any threads, may push and pop. The channel
+    // and the scheduler must outlive the suspended coroutines.
+    template <typename T, size_t Size, typename Scheduler = ReadyQueue>
+    class AsyncChannel
+    {
+    private:
+        struct Waiter
+        {
+            std::coroutine_handle<> handle;
+            Waiter *next = nullptr;
+        };
+
+        class WaiterQueue
+        {
+        private:
+            Waiter *head_ = nullptr;
+            Waiter *tail_ = nullptr;
+
+        public:
+            bool empty() const
+            {
+                return head_ == nullptr;
+            }
+
+            void push(Waiter *waiter)
+            {
+                waiter->next = nullptr;
+                if (tail_ == nullptr)
+                {
+                    head_ = waiter;
+                }
+                else
+                {
+                    tail_->next = waiter;
+                }
+                tail_ = waiter;
+            }
+
+            Waiter *pop()
+            {
+                Waiter *waiter = head_;
+                head_ = waiter->next;
+                if (head_ == nullptr)
+                {
+                    tail_ = nullptr;
+                }
+                return waiter;
+            }
+
+            // Empties the queue and returns its former head
+            Waiter *release()
+            {
+                Waiter *waiter = head_;
+                head_ = tail_ = nullptr;
+                return waiter;
+            }
+        };
+
+    public:
+        class PushAwaiter;
+        class PopAwaiter;
+
+    private:
+        Scheduler *scheduler_;
+        mutable std::mutex mutex_;
+        CircularBuffer<T, Size> buffer_;
+        WaiterQueue pushers_;
+        WaiterQueue poppers_;
+        bool closed_ = false;
+
+        // Completes a push with the channel locked, setting waking to a popper
+        // to resume once unlocked. Returns false if the pusher has to wait.
+        bool put(T &item, bool &accepted, std::coroutine_handle<> &waking)
+        {
+            if (closed_)
+            {
+                accepted = false;
+                return true;
+            }
+            if (!poppers_.empty())
+            {
+                // The buffer is empty: hand item straight to the oldest popper
+                PopAwaiter *popper = static_cast<PopAwaiter *>(poppers_.pop());
+                popper->item_.emplace(std::move(item));
+                waking = popper->handle;
+            }
+            else if (!buffer_.full())
+            {
+                buffer_.push_back(std::move(item));
+            }
+            else
+            {
+                return false;
+            }
+            accepted = true;
+            return true;
+        }
+
+        // Completes a pop with the channel locked, setting waking to a pusher
+        // to resume once unlocked. Returns false if the popper has to wait.
+        bool take(std::optional<T> &item, std::coroutine_handle<> &waking)
+        {
+            if (buffer_.empty())
+            {
+                // Pushers only wait on a full buffer, so none is waiting here
+                return closed_;
+            }
+            item.emplace(std::move(buffer_.front()));
+            buffer_.pop_front();
+            if (!pushers_.empty())
+            {
+                // Refill the freed slot from the oldest pusher
+                PushAwaiter *pusher = static_cast<PushAwaiter *>(pushers_.pop());
+                buffer_.push_back(std::move(pusher->item_));
+                pusher->accepted_ = true;
+                waking = pusher->handle;
+            }
+            return true;
+        }
+
+        void post(std::coroutine_handle<> waking)
+        {
+            if (waking)
+            {
+                scheduler_->post(waking);
+            }
+        }
+
+    public:
+        class PushAwaiter : private Waiter
+        {
+        private:
+            friend class AsyncChannel;
+
+            AsyncChannel *channel_;
+            T item_;
+            bool accepted_ = false;
+
+        public:
+            PushAwaiter(AsyncChannel &channel, T item) : channel_(&channel), item_(std::move(item)) {}
+
+            bool await_ready()
+            {
+                std::coroutine_handle<> waking;
+                {
+                    std::lock_guard<std::mutex> lock(channel_->mutex_);
+                    if (!channel_->put(item_, accepted_, waking))
+                    {
+                        return false;
+                    }
+                }
+                channel_->post(waking);
+                return true;
+            }
+
+            // Tries again under the lock, since the channel may have changed
+            // since await_ready(), and carries on with this coroutine if it
+            // no longer has to wait
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle)
+            {
+                std::coroutine_handle<> waking;
+                {
+                    std::lock_guard<std::mutex> lock(channel_->mutex_);
+                    if (!channel_->put(item_, accepted_, waking))
+                    {
+                        this->handle = handle;
+                        channel_->pushers_.push(this);
+                        return std::noop_coroutine();
+                    }
+                }
+                channel_->post(waking);
+                return handle;
+            }
+
+            // false if the channel was closed before item was accepted
+            bool await_resume() const noexcept
+            {
+                return accepted_;
+            }
+        };
+
+        class PopAwaiter : private Waiter
+        {
+        private:
+            friend class AsyncChannel;
+
+            AsyncChannel *channel_;
+            std::optional<T> item_;
+
+        public:
+            explicit PopAwaiter(AsyncChannel &channel) : channel_(&channel) {}
+
+            bool await_ready()
+            {
+                std::coroutine_handle<> waking;
+                {
+                    std::lock_guard<std::mutex> lock(channel_->mutex_);
+                    if (!channel_->take(item_, waking))
+                    {
+                        return false;
+                    }
+                }
+                channel_->post(waking);
+                return true;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle)
+            {
+                std::coroutine_handle<> waking;
+                {
+                    std::lock_guard<std::mutex> lock(channel_->mutex_);
+                    if (!channel_->take(item_, waking))
+                    {
+                        this->handle = handle;
+                        channel_->poppers_.push(this);
+                        return std::noop_coroutine();
+                    }
+                }
+                channel_->post(waking);
+                return handle;
+            }
+
+            // Empty once the channel is closed and drained
+            std::optional<T> await_resume()
+            {
+                return std::move(item_);
+            }
+        };
+
+        explicit AsyncChannel(Scheduler &scheduler) : scheduler_(&scheduler) {}
+
+        AsyncChannel(const AsyncChannel &) = delete;
+        AsyncChannel &operator=(const AsyncChannel &) = delete;
+
+        [[nodiscard]] PushAwaiter push(T item)
+        {
+            return PushAwaiter(*this, std::move(item));
+        }
+
+        [[nodiscard]] PopAwaiter pop()
+        {
+            return PopAwaiter(*this);
+        }
+
+        // Non-suspending push: false, leaving item untouched, if the channel is
+        // full or closed
+        bool try_push(T &item)
+        {
+            std::coroutine_handle<> waking;
+            bool accepted = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!put(item, accepted, waking))
+                {
+                    return false;
+                }
+            }
+            post(waking);
+            return accepted;
+        }
+
+        // Non-suspending pop: empty if the channel is empty
+        std::optional<T> try_pop()
+        {
+            std::optional<T> item;
+            std::coroutine_handle<> waking;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                take(item, waking);
+            }
+            post(waking);
+            return item;
+        }
+
+        // Refuses further pushes and posts every waiter: suspended pushes
+        // return false, suspended pops return an empty optional. Elements
+        // already in the channel can still be popped.
+        void close()
+        {
+            Waiter *pushers;
+            Waiter *poppers;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+                pushers = pushers_.release();
+                poppers = poppers_.release();
+            }
+            // A posted coroutine may already run, and destroy its awaiter, on
+            // another thread, so next is read first
+            for (Waiter *list : {pushers, poppers})
+            {
+                while (list != nullptr)
+                {
+                    Waiter *next = list->next;
+                    scheduler_->post(list->handle);
+                    list = next;
+                }
+            }
+        }
+
+        bool closed() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return closed_;
+        }
+
+        // A snapshot while other threads use the channel
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return buffer_.size();
+        }
+
+        size_t capacity() const
+        {
+            return Size;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif
+
+#endif // CXXCIRCULARBUFFER_ASYNCCHANNEL_HPP
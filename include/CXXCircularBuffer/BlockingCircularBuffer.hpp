@@ -0,0 +1,228 @@
+#ifndef CXXCIRCULARBUFFER_BLOCKINGCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_BLOCKINGCIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/MPMCCircularBuffer.hpp>
+#include <CXXCircularBuffer/OverflowPolicy.hpp>
+#include <CXXCircularBuffer/WaitStrategy.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    // MPMCCircularBuffer whose producers can wait for free space and whose
+    // consumers can wait for elements, instead of polling. WaitStrategy picks
+    // how they wait: BusySpinWait, SpinYieldWait or ParkingWait (see
+    // WaitStrategy.hpp). The try_ operations never wait; push_back follows
+    // Policy, which waits for free space by default.
+    template <typename T, size_t Size, typename WaitStrategy = ParkingWait,
+              OverflowPolicy Policy = OverflowPolicy::Block>
+    class BlockingCircularBuffer
+    {
+    private:
+        MPMCCircularBuffer<T, Size> queue_;
+        // Producers wait on not_full_, consumers on not_empty_
+        alignas(detail::CACHE_LINE_SIZE) WaitStrategy not_full_;
+        alignas(detail::CACHE_LINE_SIZE) WaitStrategy not_empty_;
+
+        // The predicates only touch the queue: notifying the other side from
+        // inside one would take both parking locks in opposite orders
+        template <typename U>
+        void push_wait_impl(U &&item)
+        {
+            // A failed enqueue leaves item untouched, so it can be retried
+            not_full_.wait([&]() { return queue_.try_enqueue(std::forward<U>(item)); });
+            not_empty_.notify();
+        }
+
+        template <typename U>
+        PushStatus push_back_impl(U &&item)
+        {
+            if constexpr (Policy == OverflowPolicy::Block)
+            {
+                push_wait_impl(std::forward<U>(item));
+                return PushStatus::Pushed;
+            }
+            else if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+            {
+                // Discards the oldest element until the new one fits; consumers
+                // may take elements meanwhile, in which case nothing is lost
+                PushStatus status = PushStatus::Pushed;
+                while (!queue_.try_enqueue(std::forward<U>(item)))
+                {
+                    if (queue_.try_consume([](T &) {}))
+                    {
+                        status = PushStatus::Overwritten;
+                    }
+                }
+                not_empty_.notify();
+                return status;
+            }
+            else
+            {
+                if (!queue_.try_enqueue(std::forward<U>(item)))
+                {
+                    return Policy == OverflowPolicy::RejectNew ? PushStatus::Rejected : PushStatus::Dropped;
+                }
+                not_empty_.notify();
+                return PushStatus::Pushed;
+            }
+        }
+
+        template <typename U, typename Clock, typename Duration>
+        bool push_wait_until_impl(U &&item, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            if (!not_full_.wait_until([&]() { return queue_.try_enqueue(std::forward<U>(item)); }, deadline))
+            {
+                return false;
+            }
+            not_empty_.notify();
+            return true;
+        }
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+        BlockingCircularBuffer() = default;
+
+        BlockingCircularBuffer(const BlockingCircularBuffer &) = delete;
+        BlockingCircularBuffer &operator=(const BlockingCircularBuffer &) = delete;
+
+        bool try_push(const T &item)
+        {
+            if (!queue_.try_enqueue(item))
+            {
+                return false;
+            }
+            not_empty_.notify();
+            return true;
+        }
+
+        bool try_push(T &&item)
+        {
+            if (!queue_.try_enqueue(std::move(item)))
+            {
+                return false;
+            }
+            not_empty_.notify();
+            return true;
+        }
+
+        bool try_pop(T &item)
+        {
+            if (!queue_.try_dequeue(item))
+            {
+                return false;
+            }
+            not_full_.notify();
+            return true;
+        }
+
+        // Applies Policy when the buffer is full
+        PushStatus push_back(const T &item)
+        {
+            return push_back_impl(item);
+        }
+
+        PushStatus push_back(T &&item)
+        {
+            return push_back_impl(std::move(item));
+        }
+
+        // Waits for free space as long as the buffer is full
+        void push_wait(const T &item)
+        {
+            push_wait_impl(item);
+        }
+
+        void push_wait(T &&item)
+        {
+            push_wait_impl(std::move(item));
+        }
+
+        // Returns false, leaving item untouched, if the buffer was still full at
+        // the deadline
+        template <typename Clock, typename Duration>
+        bool push_wait_until(const T &item, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            return push_wait_until_impl(item, deadline);
+        }
+
+        template <typename Clock, typename Duration>
+        bool push_wait_until(T &&item, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            return push_wait_until_impl(std::move(item), deadline);
+        }
+
+        template <typename Rep, typename Period>
+        bool push_wait_for(const T &item, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return push_wait_until_impl(item, std::chrono::steady_clock::now() + timeout);
+        }
+
+        template <typename Rep, typename Period>
+        bool push_wait_for(T &&item, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return push_wait_until_impl(std::move(item), std::chrono::steady_clock::now() + timeout);
+        }
+
+        // Waits for an element as long as the buffer is empty
+        void pop_wait(T &item)
+        {
+            not_empty_.wait([&]() { return queue_.try_dequeue(item); });
+            not_full_.notify();
+        }
+
+        T pop_wait()
+        {
+            T item;
+            pop_wait(item);
+            return item;
+        }
+
+        // Returns false if the buffer was still empty at the deadline
+        template <typename Clock, typename Duration>
+        bool pop_wait_until(T &item, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            if (!not_empty_.wait_until([&]() { return queue_.try_dequeue(item); }, deadline))
+            {
+                return false;
+            }
+            not_full_.notify();
+            return true;
+        }
+
+        template <typename Rep, typename Period>
+        bool pop_wait_for(T &item, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return pop_wait_until(item, std::chrono::steady_clock::now() + timeout);
+        }
+
+        // A snapshot while other threads are running
+        size_type size() const
+        {
+            return queue_.size();
+        }
+
+        bool empty() const
+        {
+            return queue_.empty();
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        size_type max_size() const
+        {
+            return Size;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_BLOCKINGCIRCULARBUFFER_HPP
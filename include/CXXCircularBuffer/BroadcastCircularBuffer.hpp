@@ -0,0 +1,346 @@
+#ifndef CXXCIRCULARBUFFER_BROADCASTCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_BROADCASTCIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    enum class BroadcastMode
+    {
+        // The producer never overwrites an element that a reader has not
+        // consumed yet: a push fails while the slowest reader is Size behind
+        Gated,
+        // The producer never waits: it overwrites the oldest elements, and a
+        // reader that fell more than Size behind skips to the oldest one still
+        // stored, counting what it missed (trivially copyable types only)
+        Lossy
+    };
+
+    // Ring with one producer thread and Readers consumer threads, where every
+    // reader sees every element (as in the LMAX Disruptor). Each element is
+    // stored once; each reader only advances its own cursor, identified by its
+    // index in [0, Readers). Reader functions taking index r may only be called
+    // from the thread of reader r.
+    template <typename T, size_t Size, size_t Readers, BroadcastMode Mode = BroadcastMode::Gated>
+    class BroadcastCircularBuffer;
+
+    namespace detail
+    {
+        // Per-reader state, on its own cache line. Only position is read by
+        // other threads.
+        struct alignas(CACHE_LINE_SIZE) BroadcastCursor
+        {
+            std::atomic<std::uint64_t> position{0};
+            // Reader's last observed value of the producer sequence
+            std::uint64_t published = 0;
+            // Elements overwritten before this reader got to them
+            std::uint64_t dropped = 0;
+        };
+
+        template <std::size_t Size>
+        constexpr std::size_t broadcast_slot(std::uint64_t sequence)
+        {
+            if constexpr (is_power_of_two(Size))
+            {
+                return static_cast<std::size_t>(sequence & (Size - 1));
+            }
+            else
+            {
+                return static_cast<std::size_t>(sequence % Size);
+            }
+        }
+    }
+
+    template <typename T, size_t Size, size_t Readers>
+    class BroadcastCircularBuffer<T, Size, Readers, BroadcastMode::Gated>
+    {
+        static_assert(Size > 0, "BroadcastCircularBuffer capacity must be greater than zero");
+        static_assert(Readers > 0, "BroadcastCircularBuffer needs at least one reader");
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+    private:
+        // Number of elements published so far; element n lives in slot n % Size
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> published_{0};
+        // Producer's last observed position of the slowest reader
+        std::uint64_t cached_gate_ = 0;
+
+        detail::BroadcastCursor cursors_[Readers];
+
+        alignas(detail::CACHE_LINE_SIZE) detail::UninitializedArray<T, Size> slots_;
+
+        std::uint64_t slowest_reader() const
+        {
+            std::uint64_t slowest = cursors_[0].position.load(std::memory_order_acquire);
+            for (std::size_t r = 1; r < Readers; ++r)
+            {
+                const std::uint64_t position = cursors_[r].position.load(std::memory_order_acquire);
+                slowest = position < slowest ? position : slowest;
+            }
+            return slowest;
+        }
+
+        template <typename U>
+        bool push(U &&item)
+        {
+            const std::uint64_t head = published_.load(std::memory_order_relaxed);
+            if (head - cached_gate_ >= Size)
+            {
+                cached_gate_ = slowest_reader();
+                if (head - cached_gate_ >= Size)
+                {
+                    return false;
+                }
+            }
+            const std::size_t slot = detail::broadcast_slot<Size>(head);
+            if (head < Size)
+            {
+                slots_.construct(slot, std::forward<U>(item));
+            }
+            else
+            {
+                slots_[slot] = std::forward<U>(item);
+            }
+            published_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Elements published but not yet consumed by reader
+        std::uint64_t available(std::size_t reader, std::uint64_t position, std::uint64_t wanted)
+        {
+            detail::BroadcastCursor &cursor = cursors_[reader];
+            if (cursor.published - position < wanted)
+            {
+                cursor.published = published_.load(std::memory_order_acquire);
+            }
+            return cursor.published - position;
+        }
+
+    public:
+        BroadcastCircularBuffer() = default;
+
+        ~BroadcastCircularBuffer()
+        {
+            const std::uint64_t published = published_.load(std::memory_order_relaxed);
+            const std::size_t constructed = published < Size ? static_cast<std::size_t>(published) : Size;
+            for (std::size_t i = 0; i < constructed; ++i)
+            {
+                slots_.destroy(i);
+            }
+        }
+
+        BroadcastCircularBuffer(const BroadcastCircularBuffer &) = delete;
+        BroadcastCircularBuffer &operator=(const BroadcastCircularBuffer &) = delete;
+
+        // Producer only. Fails while the slowest reader is Size elements behind.
+        bool try_push(const T &item)
+        {
+            return push(item);
+        }
+
+        bool try_push(T &&item)
+        {
+            return push(std::move(item));
+        }
+
+        // Reader only. Copies the next element for this reader into item.
+        bool try_read(size_type reader, T &item)
+        {
+            detail::BroadcastCursor &cursor = cursors_[reader];
+            const std::uint64_t position = cursor.position.load(std::memory_order_relaxed);
+            if (available(reader, position, 1) == 0)
+            {
+                return false;
+            }
+            item = slots_[detail::broadcast_slot<Size>(position)];
+            cursor.position.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Reader only. Up to count of the next elements for this reader, in
+        // place; the producer cannot overwrite them before consume().
+        Segments<const T> peek(size_type reader, size_type count)
+        {
+            const std::uint64_t position = cursors_[reader].position.load(std::memory_order_relaxed);
+            const std::uint64_t ready = available(reader, position, count);
+            count = ready < count ? static_cast<size_type>(ready) : count;
+            const std::size_t start = detail::broadcast_slot<Size>(position);
+            const std::size_t first_segment = count < Size - start ? count : Size - start;
+            return Segments<const T>{Span<const T>(slots_.data() + start, first_segment),
+                                     Span<const T>(slots_.data(), count - first_segment)};
+        }
+
+        // Reader only. Releases the first count elements returned by peek().
+        void consume(size_type reader, size_type count)
+        {
+            detail::BroadcastCursor &cursor = cursors_[reader];
+            cursor.position.store(cursor.position.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        // Elements published that reader has not consumed yet; a snapshot while
+        // other threads are running
+        std::uint64_t lag(size_type reader) const
+        {
+            return published_.load(std::memory_order_acquire) -
+                   cursors_[reader].position.load(std::memory_order_acquire);
+        }
+
+        // Always 0: a gated producer never overwrites
+        std::uint64_t dropped(size_type) const
+        {
+            return 0;
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        size_type readers() const
+        {
+            return Readers;
+        }
+    };
+
+    template <typename T, size_t Size, size_t Readers>
+    class BroadcastCircularBuffer<T, Size, Readers, BroadcastMode::Lossy>
+    {
+        static_assert(Size > 0, "BroadcastCircularBuffer capacity must be greater than zero");
+        static_assert(Readers > 0, "BroadcastCircularBuffer needs at least one reader");
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "lossy broadcast requires a trivially copyable type");
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+    private:
+        // Payload size in 64-bit words
+        static constexpr std::size_t Words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        // Seqlock slot: sequence is 2n + 1 while element n is being written and
+        // 2n + 2 once it is complete, so a reader can detect a torn copy. The
+        // payload is held in atomic words, since a reader may copy it while
+        // the producer overwrites it.
+        struct Slot
+        {
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::uint64_t> words[Words] = {};
+        };
+
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> published_{0};
+
+        detail::BroadcastCursor cursors_[Readers];
+
+        alignas(detail::CACHE_LINE_SIZE) Slot slots_[Size];
+
+    public:
+        BroadcastCircularBuffer() = default;
+
+        BroadcastCircularBuffer(const BroadcastCircularBuffer &) = delete;
+        BroadcastCircularBuffer &operator=(const BroadcastCircularBuffer &) = delete;
+
+        // Producer only. Never fails: overwrites the oldest element when the
+        // ring is full, whatever the readers' positions.
+        void push(const T &item)
+        {
+            const std::uint64_t head = published_.load(std::memory_order_relaxed);
+            Slot &slot = slots_[detail::broadcast_slot<Size>(head)];
+            std::uint64_t words[Words] = {};
+            std::memcpy(words, &item, sizeof(T));
+            slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+            // Release stores (plain moves on x86): a reader that loads any of
+            // these words also sees the odd sequence when it checks again
+            for (std::size_t i = 0; i < Words; ++i)
+            {
+                slot.words[i].store(words[i], std::memory_order_release);
+            }
+            slot.sequence.store(2 * head + 2, std::memory_order_release);
+            published_.store(head + 1, std::memory_order_release);
+        }
+
+        bool try_push(const T &item)
+        {
+            push(item);
+            return true;
+        }
+
+        // Reader only. Copies the next element for this reader into item. A
+        // reader that was overtaken first skips to the oldest element still
+        // stored, adding the elements it missed to dropped().
+        bool try_read(size_type reader, T &item)
+        {
+            detail::BroadcastCursor &cursor = cursors_[reader];
+            std::uint64_t position = cursor.position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const std::uint64_t head = published_.load(std::memory_order_acquire);
+                if (position == head)
+                {
+                    return false;
+                }
+                if (head - position > Size)
+                {
+                    cursor.dropped += head - Size - position;
+                    position = head - Size;
+                }
+
+                const Slot &slot = slots_[detail::broadcast_slot<Size>(position)];
+                const std::uint64_t expected = 2 * position + 2;
+                if (slot.sequence.load(std::memory_order_acquire) == expected)
+                {
+                    std::uint64_t words[Words];
+                    for (std::size_t i = 0; i < Words; ++i)
+                    {
+                        words[i] = slot.words[i].load(std::memory_order_acquire);
+                    }
+                    if (slot.sequence.load(std::memory_order_relaxed) == expected)
+                    {
+                        std::memcpy(&item, words, sizeof(T));
+                        cursor.position.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                // Overwritten while being read: the next round skips ahead
+            }
+        }
+
+        // Elements published that reader has not read yet, including the ones
+        // already overwritten; a snapshot while other threads are running
+        std::uint64_t lag(size_type reader) const
+        {
+            return published_.load(std::memory_order_acquire) -
+                   cursors_[reader].position.load(std::memory_order_acquire);
+        }
+
+        // Reader only. Total elements this reader missed because the producer
+        // overwrote them first.
+        std::uint64_t dropped(size_type reader) const
+        {
+            return cursors_[reader].dropped;
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        size_type readers() const
+        {
+            return Readers;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_BROADCASTCIRCULARBUFFER_HPP
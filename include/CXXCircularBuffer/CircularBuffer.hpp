@@ -1,21 +1,91 @@
 #ifndef CXXCIRCULARBUFFER_CIRCULARBUFFER_HPP
 #define CXXCIRCULARBUFFER_CIRCULARBUFFER_HPP
 
+#include <CXXCircularBuffer/CircularBufferIterator.hpp>
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/OverflowPolicy.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+#include <CXXCircularBuffer/Statistics.hpp>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace CXXCircularBuffer
 {
+    namespace detail
+    {
+        // Elements and counters of a CircularBuffer. Only the slots between tail_
+        // and head_ hold constructed elements, which the storage destroys with
+        // the buffer. Trivial types are kept in a TrivialArray instead, with
+        // nothing to destroy, so that their buffers are trivially destructible
+        // and, with C++20, literal types.
+        template <typename T, std::size_t Size, bool Trivial = std::is_trivial<T>::value>
+        class CircularBufferStorage
+        {
+        protected:
+            UninitializedArray<T, Size> buffer_;
+            // Counters, not slot indices: see detail::RingIndex
+            std::size_t head_ = 0;
+            std::size_t tail_ = 0;
 
-    template <typename T, size_t Size>
-    class CircularBuffer
+            CircularBufferStorage() = default;
+
+            ~CircularBufferStorage()
+            {
+                if constexpr (!std::is_trivially_destructible<T>::value)
+                {
+                    for (std::size_t counter = tail_; counter != head_; counter = RingIndex<Size>::advance(counter, 1))
+                    {
+                        buffer_.destroy(RingIndex<Size>::slot(counter));
+                    }
+                }
+            }
+        };
+
+        template <typename T, std::size_t Size>
+        class CircularBufferStorage<T, Size, true>
+        {
+        protected:
+            TrivialArray<T, Size> buffer_;
+            std::size_t head_ = 0;
+            std::size_t tail_ = 0;
+
+            CircularBufferStorage() = default;
+        };
+    } // namespace detail
+
+    // Policy decides what a push into a full buffer does; see OverflowPolicy.
+    // Instrumented enables the counters returned by statistics().
+    //
+    // Elements live inside the object, so a buffer needs no allocation and can
+    // be placed on the stack, in shared memory or inside other structs. With
+    // C++20, for trivial types without statistics, the buffer can also be
+    // built, filled and read in constant expressions, and a constexpr buffer
+    // is stored precomputed. Its slots are zeroed only during constant
+    // evaluation; at run time they stay uninitialized. Bulk operations, which
+    // copy with memcpy, are run-time only.
+    template <typename T, size_t Size, OverflowPolicy Policy = OverflowPolicy::OverwriteOldest,
+              bool Instrumented = false>
+    class CircularBuffer : private detail::CircularBufferStorage<T, Size>,
+                           private detail::StatisticsCounters<Instrumented>
     {
+        static_assert(Size > 0, "CircularBuffer capacity must be greater than zero");
+        static_assert(Policy != OverflowPolicy::Block,
+                      "nothing else can make room in a single-threaded buffer: use BlockingCircularBuffer");
 
     private:
-        T *buffer_;
-        std::size_t head_ = 0;
-        std::size_t tail_ = 0;
-        bool full_ = false;
+        typedef detail::RingIndex<Size> Index;
+        typedef detail::CircularBufferStorage<T, Size> Storage;
+        typedef detail::StatisticsCounters<Instrumented> Counters;
+
+        using Storage::buffer_;
+        using Storage::head_;
+        using Storage::tail_;
 
     public:
         typedef T value_type;
@@ -26,504 +96,706 @@ namespace CXXCircularBuffer
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
 
-        // Const iterator class
-        class const_iterator
-        {
-        private:
-            const CircularBuffer *buffer_;
-            std::size_t index_;
-            std::size_t position_;
-
-        public:
-            typedef std::random_access_iterator_tag iterator_category;
-            typedef T value_type;
-            typedef ptrdiff_t difference_type;
-            typedef const T *pointer;
-            typedef const T &reference;
-
-            const_iterator() : buffer_(nullptr), index_(0), position_(0) {}
-
-            const_iterator(const CircularBuffer *buf, std::size_t idx, std::size_t pos)
-                : buffer_(buf), index_(idx), position_(pos) {}
-
-            // // Conversion from iterator to const_iterator
-            // const_iterator(const iterator &it)
-            //     : buffer_(it.buffer_), index_(it.index_), position_(it.position_) {}
+        typedef detail::RingIterator<CircularBuffer, false> const_iterator;
+        typedef const_iterator CircularBufferIterator;
+        typedef detail::RingIterator<CircularBuffer, true> const_reverse_iterator;
 
-            reference operator*() const { return buffer_->buffer_[index_]; }
-            pointer operator->() const { return &buffer_->buffer_[index_]; }
+        CircularBuffer() = default;
 
-            const_iterator &operator++()
-            {
-                index_ = (index_ + 1) % Size;
-                ++position_;
-                return *this;
-            }
-
-            const_iterator operator++(int)
-            {
-                const_iterator tmp = *this;
-                ++(*this);
-                return tmp;
-            }
-
-            const_iterator &operator--()
-            {
-                index_ = (index_ == 0) ? Size - 1 : index_ - 1;
-                --position_;
-                return *this;
-            }
-
-            const_iterator operator--(int)
-            {
-                const_iterator tmp = *this;
-                --(*this);
-                return tmp;
-            }
-
-            const_iterator &operator+=(difference_type n)
-            {
-                position_ += n;
-                index_ = (index_ + n) % Size;
-                return *this;
-            }
-
-            const_iterator &operator-=(difference_type n)
-            {
-                return *this += (-n);
-            }
-
-            const_iterator operator+(difference_type n) const
-            {
-                const_iterator tmp = *this;
-                return tmp += n;
-            }
-
-            const_iterator operator-(difference_type n) const
-            {
-                const_iterator tmp = *this;
-                return tmp -= n;
-            }
-
-            difference_type operator-(const const_iterator &other) const
-            {
-                return position_ - other.position_;
-            }
-
-            reference operator[](difference_type n) const
+        constexpr CircularBuffer(const CircularBuffer &other) : Storage(), Counters()
+        {
+            if constexpr (std::is_nothrow_copy_constructible<T>::value)
             {
-                return *(*this + n);
+                copy_elements_from(other);
             }
-
-            bool operator==(const const_iterator &other) const
+            else
             {
-                return buffer_ == other.buffer_ && position_ == other.position_;
+                fill_or_clear([this, &other]() { copy_elements_from(other); });
             }
+        }
 
-            bool operator!=(const const_iterator &other) const
+        constexpr CircularBuffer(CircularBuffer &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : Storage(), Counters()
+        {
+            if constexpr (std::is_nothrow_move_constructible<T>::value)
             {
-                return !(*this == other);
+                move_elements_from(other);
             }
-
-            bool operator<(const const_iterator &other) const
+            else
             {
-                return position_ < other.position_;
+                fill_or_clear([this, &other]() { move_elements_from(other); });
             }
+            other.clear();
+        }
 
-            bool operator>(const const_iterator &other) const
+        constexpr CircularBuffer &operator=(const CircularBuffer &other)
+        {
+            if (this != &other)
             {
-                return other < *this;
+                clear();
+                copy_elements_from(other);
             }
+            return *this;
+        }
 
-            bool operator<=(const const_iterator &other) const
+        constexpr CircularBuffer &operator=(CircularBuffer &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &other)
             {
-                return !(other < *this);
+                clear();
+                move_elements_from(other);
+                other.clear();
             }
+            return *this;
+        }
 
-            bool operator>=(const const_iterator &other) const
-            {
-                return !(*this < other);
-            }
-        };
+        constexpr size_type size() const
+        {
+            return Index::distance(tail_, head_);
+        }
 
-        // Iterator class
-        class CircularBufferIterator
+        constexpr size_type capacity() const
         {
-        private:
-            const CircularBuffer *buffer_;
-            std::size_t index_;
-            std::size_t position_;
+            return Size;
+        }
 
-        public:
-            typedef std::random_access_iterator_tag iterator_category;
-            typedef T value_type;
-            typedef ptrdiff_t difference_type;
-            typedef const T *pointer;
-            typedef const T &reference;
+        constexpr size_type max_size() const
+        {
+            return Size;
+        }
 
-            CircularBufferIterator() : buffer_(nullptr), index_(0), position_(0) {}
+        constexpr bool empty() const
+        {
+            return head_ == tail_;
+        }
 
-            CircularBufferIterator(const CircularBuffer *buf, std::size_t idx, std::size_t pos)
-                : buffer_(buf), index_(idx), position_(pos) {}
+        constexpr bool full() const
+        {
+            return size() == Size;
+        }
 
-            reference operator*() const { return buffer_->buffer_[index_]; }
-            pointer operator->() const { return &buffer_->buffer_[index_]; }
+        constexpr reference front()
+        {
+            return buffer_[Index::slot(tail_)];
+        }
 
-            CircularBufferIterator &operator++()
-            {
-                index_ = (index_ + 1) % Size;
-                ++position_;
-                return *this;
-            }
+        constexpr reference back()
+        {
+            return buffer_[Index::slot(Index::retreat(head_, 1))];
+        }
 
-            CircularBufferIterator operator++(int)
-            {
-                CircularBufferIterator tmp = *this;
-                ++(*this);
-                return tmp;
-            }
+        constexpr const_reference front() const
+        {
+            return buffer_[Index::slot(tail_)];
+        }
 
-            CircularBufferIterator &operator--()
-            {
-                index_ = (index_ == 0) ? Size - 1 : index_ - 1;
-                --position_;
-                return *this;
-            }
+        constexpr const_reference back() const
+        {
+            return buffer_[Index::slot(Index::retreat(head_, 1))];
+        }
 
-            CircularBufferIterator operator--(int)
+        constexpr void clear()
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
             {
-                CircularBufferIterator tmp = *this;
-                --(*this);
-                return tmp;
+                for (std::size_t counter = tail_; counter != head_; counter = Index::advance(counter, 1))
+                {
+                    buffer_.destroy(Index::slot(counter));
+                }
             }
+            head_ = tail_ = 0;
+            this->record_not_full();
+        }
 
-            CircularBufferIterator &operator+=(difference_type n)
-            {
-                position_ += n;
-                index_ = (index_ + n) % Size;
-                return *this;
-            }
+        // Follows Policy when the buffer is full; try_push_back() tells what happened
+        constexpr void push_back(const T &item)
+        {
+            emplace_value(item);
+        }
 
-            CircularBufferIterator &operator-=(difference_type n)
-            {
-                return *this += (-n);
-            }
+        constexpr void push_back(T &&item)
+        {
+            emplace_value(std::move(item));
+        }
 
-            CircularBufferIterator operator+(difference_type n) const
-            {
-                CircularBufferIterator tmp = *this;
-                return tmp += n;
-            }
+        constexpr PushStatus try_push_back(const T &item)
+        {
+            return emplace_value(item);
+        }
 
-            CircularBufferIterator operator-(difference_type n) const
-            {
-                CircularBufferIterator tmp = *this;
-                return tmp -= n;
-            }
+        constexpr PushStatus try_push_back(T &&item)
+        {
+            return emplace_value(std::move(item));
+        }
 
-            difference_type operator-(const CircularBufferIterator &other) const
-            {
-                return position_ - other.position_;
-            }
+        // Constructs the new element in place. When the buffer is full the
+        // oldest element is replaced by a temporary built from args, so args
+        // may safely refer to elements of the buffer.
+        template <typename... Args>
+        constexpr reference emplace_back(Args &&...args)
+        {
+            static_assert(Policy == OverflowPolicy::OverwriteOldest,
+                          "emplace_back always stores the element: use try_emplace_back");
+            return emplace_unchecked(std::forward<Args>(args)...);
+        }
 
-            reference operator[](difference_type n) const
+        template <typename... Args>
+        constexpr PushStatus try_emplace_back(Args &&...args)
+        {
+            if constexpr (Policy == OverflowPolicy::OverwriteOldest)
             {
-                return *(*this + n);
+                const bool overwrite = full();
+                emplace_unchecked(std::forward<Args>(args)...);
+                return overwrite ? PushStatus::Overwritten : PushStatus::Pushed;
             }
-
-            bool operator==(const CircularBufferIterator &other) const
+            else
             {
-                return buffer_ == other.buffer_ && position_ == other.position_;
+                if (full())
+                {
+                    this->record_rejection(1);
+                    return overflow_status();
+                }
+                emplace_unchecked(std::forward<Args>(args)...);
+                return PushStatus::Pushed;
             }
+        }
 
-            bool operator!=(const CircularBufferIterator &other) const
+        // Destroys the oldest element, releasing whatever it owns
+        constexpr void pop_front()
+        {
+            if (!empty())
             {
-                return !(*this == other);
+                buffer_.destroy(Index::slot(tail_));
+                tail_ = Index::advance(tail_, 1);
+                popped(1);
             }
+        }
 
-            bool operator<(const CircularBufferIterator &other) const
+        // Moves the oldest element into item and destroys it. Returns false,
+        // leaving item untouched, when the buffer is empty.
+        constexpr bool pop_front(T &item)
+        {
+            if (empty())
             {
-                return position_ < other.position_;
+                return false;
             }
+            const std::size_t slot = Index::slot(tail_);
+            item = std::move(buffer_[slot]);
+            buffer_.destroy(slot);
+            tail_ = Index::advance(tail_, 1);
+            popped(1);
+            return true;
+        }
 
-            bool operator>(const CircularBufferIterator &other) const
+        // Destroys the newest element
+        constexpr void pop_back()
+        {
+            if (!empty())
             {
-                return other < *this;
+                head_ = Index::retreat(head_, 1);
+                buffer_.destroy(Index::slot(head_));
+                popped(1);
             }
+        }
 
-            bool operator<=(const CircularBufferIterator &other) const
-            {
-                return !(other < *this);
+        // Appends [first, last) with the same semantics as calling push_back for
+        // every element: with OverwriteOldest only the last Size elements are
+        // kept, with the other policies only the elements that fit. Returns the
+        // number of elements of the range now stored in the buffer.
+        // Forward ranges are written in at most two contiguous segments.
+        template <typename InputIt,
+                  typename Category = typename std::iterator_traits<InputIt>::iterator_category>
+        size_type push_back(InputIt first, InputIt last)
+        {
+            if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+            {
+                const std::size_t total = static_cast<std::size_t>(std::distance(first, last));
+                std::size_t count = total;
+                if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+                {
+                    const std::size_t used = size();
+                    if (used + total > Size)
+                    {
+                        this->record_overwrite(used + total - Size);
+                    }
+                    if (count > Size)
+                    {
+                        // Everything currently stored would be overwritten as well
+                        clear();
+                        std::advance(first, count - Size);
+                        count = Size;
+                    }
+                    append_n(first, count);
+                    pushed(total);
+                }
+                else
+                {
+                    count = std::min(count, Size - size());
+                    if (count != total)
+                    {
+                        this->record_rejection(total - count);
+                    }
+                    append_n(first, count);
+                    pushed(count);
+                }
+                return count;
             }
-
-            bool operator>=(const CircularBufferIterator &other) const
+            else
             {
-                return !(*this < other);
+                // Every element is offered, so that each refused one is
+                // counted as on the forward path
+                std::size_t count = 0;
+                for (; first != last; ++first)
+                {
+                    if (stored(emplace_value(*first)))
+                    {
+                        ++count;
+                    }
+                }
+                return std::min(count, Size);
             }
-        };
+        }
 
-        // Const reverse iterator class
-        class const_reverse_iterator
+        size_type push_back(Span<const T> items)
         {
-        private:
-            const CircularBuffer *buffer_;
-            std::size_t index_;
-            std::size_t position_;
-
-        public:
-            typedef std::random_access_iterator_tag iterator_category;
-            typedef T value_type;
-            typedef ptrdiff_t difference_type;
-            typedef const T *pointer;
-            typedef const T &reference;
-
-            const_reverse_iterator() : buffer_(nullptr), index_(0), position_(0) {}
+            return push_back(items.begin(), items.end());
+        }
 
-            const_reverse_iterator(const CircularBuffer *buf, std::size_t idx, std::size_t pos)
-                : buffer_(buf), index_(idx), position_(pos) {}
+        // Destroys up to count of the oldest elements and returns how many were
+        // removed. Named apart from pop_front(T &) so that a count can never be
+        // taken for an element to move into.
+        constexpr size_type pop_front_n(size_type count)
+        {
+            count = std::min(count, size());
+            destroy_front(count);
+            popped(count);
+            return count;
+        }
 
-            // // Conversion from reverse_iterator to const_reverse_iterator
-            // const_reverse_iterator(const reverse_iterator &it)
-            //     : buffer_(it.buffer_), index_(it.index_), position_(it.position_) {}
+        // Copies up to count of the oldest elements to dest, oldest first,
+        // without removing them. Returns the number of elements copied.
+        template <typename OutputIt>
+        size_type copy_out(OutputIt dest, size_type count) const
+        {
+            count = std::min(count, size());
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t first_segment = std::min(count, Size - start);
+            dest = copy_segment(buffer_.data() + start, first_segment, dest);
+            copy_segment(buffer_.data(), count - first_segment, dest);
+            return count;
+        }
 
-            reference operator*() const { return buffer_->buffer_[index_]; }
-            pointer operator->() const { return &buffer_->buffer_[index_]; }
+        // Oldest contiguous run of elements. Together with array_two() it covers
+        // the whole content in order, without copying.
+        constexpr Span<T> array_one()
+        {
+            const std::size_t start = Index::slot(tail_);
+            return Span<T>(buffer_.data() + start, std::min(size(), Size - start));
+        }
 
-            const_reverse_iterator &operator++()
-            {
-                index_ = (index_ == 0) ? Size - 1 : index_ - 1;
-                ++position_;
-                return *this;
-            }
+        // Remaining elements that wrapped to the beginning of the storage,
+        // empty when the content is already contiguous
+        constexpr Span<T> array_two()
+        {
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t used = size();
+            return Span<T>(buffer_.data(), used - std::min(used, Size - start));
+        }
 
-            const_reverse_iterator operator++(int)
-            {
-                const_reverse_iterator tmp = *this;
-                ++(*this);
-                return tmp;
-            }
+        constexpr Span<const T> array_one() const
+        {
+            const std::size_t start = Index::slot(tail_);
+            return Span<const T>(buffer_.data() + start, std::min(size(), Size - start));
+        }
 
-            const_reverse_iterator &operator--()
-            {
-                index_ = (index_ + 1) % Size;
-                --position_;
-                return *this;
-            }
+        constexpr Span<const T> array_two() const
+        {
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t used = size();
+            return Span<const T>(buffer_.data(), used - std::min(used, Size - start));
+        }
 
-            const_reverse_iterator operator--(int)
-            {
-                const_reverse_iterator tmp = *this;
-                --(*this);
-                return tmp;
-            }
+        // Unused slots following the newest element, where a producer can write
+        // directly. Together with free_array_two() it covers all the free space;
+        // the written elements become visible once published with commit().
+        Span<T> free_array_one()
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            const std::size_t start = Index::slot(head_);
+            return Span<T>(buffer_.data() + start, std::min(Size - size(), Size - start));
+        }
 
-            const_reverse_iterator &operator+=(difference_type n)
-            {
-                position_ += n;
-                // Move backwards in the buffer
-                index_ = (index_ - n % Size + Size) % Size;
-                return *this;
-            }
+        Span<T> free_array_two()
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            const std::size_t start = Index::slot(head_);
+            const std::size_t available = Size - size();
+            return Span<T>(buffer_.data(), available - std::min(available, Size - start));
+        }
 
-            const_reverse_iterator &operator-=(difference_type n)
-            {
-                position_ -= n;
-                // Move forward in the buffer
-                index_ = (index_ + n % Size) % Size;
-                return *this;
-            }
+        // Appends the first count elements written into the free space
+        void commit(size_type count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            count = std::min(count, Size - size());
+            head_ = Index::advance(head_, count);
+            pushed(count);
+        }
 
-            const_reverse_iterator operator+(difference_type n) const
-            {
-                const_reverse_iterator tmp = *this;
-                return tmp += n;
-            }
+        // Two-phase write: returns count slots following the newest element to
+        // be filled in place, then published with commit(count). When fewer are
+        // free, OverwriteOldest evicts the oldest elements right away, as
+        // push_back would; the other policies return only the free slots.
+        Segments<T> reserve(size_type count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            count = std::min(count, Size);
+            const size_type available = Size - size();
+            if (count > available)
+            {
+                if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+                {
+                    destroy_front(count - available);
+                    this->record_overwrite(count - available);
+                }
+                else
+                {
+                    count = available;
+                }
+            }
+            const std::size_t start = Index::slot(head_);
+            const std::size_t first_segment = std::min(count, Size - start);
+            return Segments<T>{Span<T>(buffer_.data() + start, first_segment),
+                               Span<T>(buffer_.data(), count - first_segment)};
+        }
 
-            const_reverse_iterator operator-(difference_type n) const
-            {
-                const_reverse_iterator tmp = *this;
-                return tmp -= n;
-            }
+        // Two-phase read: up to count of the oldest elements, in place. They stay
+        // in the buffer until released with consume().
+        constexpr Segments<T> peek(size_type count)
+        {
+            count = std::min(count, size());
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t first_segment = std::min(count, Size - start);
+            return Segments<T>{Span<T>(buffer_.data() + start, first_segment),
+                               Span<T>(buffer_.data(), count - first_segment)};
+        }
 
-            difference_type operator-(const const_reverse_iterator &other) const
-            {
-                return position_ - other.position_;
-            }
+        constexpr Segments<const T> peek(size_type count) const
+        {
+            count = std::min(count, size());
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t first_segment = std::min(count, Size - start);
+            return Segments<const T>{Span<const T>(buffer_.data() + start, first_segment),
+                                     Span<const T>(buffer_.data(), count - first_segment)};
+        }
 
-            reference operator[](difference_type n) const
-            {
-                return *(*this + n);
-            }
+        // Removes up to count of the oldest elements once read through peek()
+        constexpr size_type consume(size_type count)
+        {
+            return pop_front_n(count);
+        }
 
-            bool operator==(const const_reverse_iterator &other) const
-            {
-                return buffer_ == other.buffer_ && position_ == other.position_;
-            }
+        constexpr const_reference operator[](size_type index) const
+        {
+            return buffer_[Index::slot(Index::advance(tail_, index))];
+        }
 
-            bool operator!=(const const_reverse_iterator &other) const
-            {
-                return !(*this == other);
-            }
+        BufferStatistics statistics() const
+        {
+            static_assert(Instrumented, "statistics require CircularBuffer<T, Size, Policy, true>");
+            return Counters::statistics();
+        }
 
-            bool operator<(const const_reverse_iterator &other) const
-            {
-                return position_ < other.position_;
-            }
+        void reset_statistics()
+        {
+            static_assert(Instrumented, "statistics require CircularBuffer<T, Size, Policy, true>");
+            Counters::reset_statistics();
+        }
 
-            bool operator>(const const_reverse_iterator &other) const
-            {
-                return other < *this;
-            }
+        constexpr const_iterator begin() const
+        {
+            return const_iterator(this, Index::slot(tail_), 0);
+        }
 
-            bool operator<=(const const_reverse_iterator &other) const
-            {
-                return !(other < *this);
-            }
+        constexpr const_iterator end() const
+        {
+            return const_iterator(this, Index::slot(head_), size());
+        }
 
-            bool operator>=(const const_reverse_iterator &other) const
-            {
-                return !(*this < other);
-            }
-        };
+        constexpr const_iterator cbegin() const
+        {
+            return begin();
+        }
 
-        CircularBuffer() : buffer_(new T[Size]), head_(0), tail_(0), full_(false) {}
+        constexpr const_iterator cend() const
+        {
+            return end();
+        }
 
-        virtual ~CircularBuffer()
+        constexpr const_reverse_iterator rbegin() const
         {
-            delete[] buffer_;
-        };
+            std::size_t last_index = Index::slot(Index::retreat(head_, 1));
+            return const_reverse_iterator(this, last_index, 0);
+        }
 
-        size_type size() const
+        constexpr const_reverse_iterator rend() const
         {
-            if (full_)
-            {
-                return Size;
-            }
-            else
-            {
-                return (head_ >= tail_) ? (head_ - tail_) : (Size - tail_ + head_);
-            }
+            std::size_t before_tail = Index::slot(Index::retreat(tail_, 1));
+            return const_reverse_iterator(this, before_tail, size());
         }
 
-        size_type capacity() const
+        constexpr const_reverse_iterator crbegin() const
         {
-            return Size;
+            return rbegin();
         }
 
-        size_type max_size() const
+        constexpr const_reverse_iterator crend() const
         {
-            return Size;
+            return rend();
         }
 
-        bool empty() const
+    private:
+        template <typename, bool>
+        friend class detail::RingIterator;
+
+        constexpr const_reference slot(std::size_t index) const
         {
-            if (full_)
-            {
-                return false;
-            }
-            else
-            {
-                return head_ == tail_;
-            }
+            return buffer_[index];
         }
 
-        reference front()
+        static constexpr std::size_t step(std::size_t index, std::ptrdiff_t n)
         {
-            return buffer_[tail_];
+            return Index::step(index, n);
         }
 
-        reference back()
+        constexpr void pushed(std::size_t count)
         {
-            return buffer_[head_ == 0 ? Size - 1 : head_ - 1];
+            this->record_push(count, size());
+            if (full())
+            {
+                this->record_full();
+            }
         }
 
-        const_reference front() const
+        constexpr void popped(std::size_t count)
         {
-            return buffer_[tail_];
+            this->record_pop(count);
+            this->record_not_full();
         }
 
-        const_reference back() const
+        // Destroys the count <= size() oldest elements
+        constexpr void destroy_front(std::size_t count)
         {
-            return buffer_[head_ == 0 ? Size - 1 : head_ - 1];
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    buffer_.destroy(Index::slot(Index::advance(tail_, i)));
+                }
+            }
+            tail_ = Index::advance(tail_, count);
         }
 
-        void clear()
+        static constexpr PushStatus overflow_status()
         {
-            head_ = tail_ = 0;
-            full_ = false;
+            return Policy == OverflowPolicy::RejectNew ? PushStatus::Rejected : PushStatus::Dropped;
         }
 
-        void push_back(const T &item)
+        // Overwriting a full buffer assigns over the oldest element, so types
+        // such as std::string can reuse the storage they already own
+        template <typename U>
+        constexpr PushStatus emplace_value(U &&item)
         {
-            bool isEmpty = empty();
-            buffer_[head_] = item;
-            head_ = (head_ + 1) % Size;
-            if (!isEmpty && head_ == tail_ % Size)
+            const std::size_t slot = Index::slot(head_);
+            if (!full())
             {
-                full_ = true;
+                buffer_.construct(slot, std::forward<U>(item));
+                head_ = Index::advance(head_, 1);
+                pushed(1);
+                return PushStatus::Pushed;
             }
-            else if (!isEmpty && head_ == (tail_ + 1) % Size)
+            if constexpr (Policy == OverflowPolicy::OverwriteOldest)
             {
-                tail_ = (tail_ + 1) % Size;
+                buffer_[slot] = std::forward<U>(item);
+                tail_ = Index::advance(tail_, 1);
+                head_ = Index::advance(head_, 1);
+                this->record_overwrite(1);
+                pushed(1);
+                return PushStatus::Overwritten;
             }
-        }
-
-        void pop_front()
-        {
-            if (!empty())
+            else
             {
-                tail_ = (tail_ + 1) % Size;
-                full_ = false;
+                this->record_rejection(1);
+                return overflow_status();
             }
         }
 
-        const_reference operator[](size_type index) const
+        // Stores the new element whatever the policy, overwriting the oldest
+        template <typename... Args>
+        constexpr reference emplace_unchecked(Args &&...args)
         {
-            return buffer_[(tail_ + index) % Size];
+            const std::size_t slot = Index::slot(head_);
+            if (full())
+            {
+                buffer_[slot] = T(std::forward<Args>(args)...);
+                tail_ = Index::advance(tail_, 1);
+                this->record_overwrite(1);
+            }
+            else
+            {
+                buffer_.construct(slot, std::forward<Args>(args)...);
+            }
+            head_ = Index::advance(head_, 1);
+            pushed(1);
+            return buffer_[slot];
         }
 
-        const_iterator begin() const
+        // Appends count <= Size elements read from first, dropping the oldest
+        // elements that do not fit, in at most two contiguous segments
+        template <typename ForwardIt>
+        void append_n(ForwardIt first, std::size_t count)
         {
-            return const_iterator(this, tail_, 0);
+            const std::size_t used = size();
+            if (used + count > Size)
+            {
+                destroy_front(used + count - Size);
+            }
+            const std::size_t start = Index::slot(head_);
+            const std::size_t first_segment = std::min(count, Size - start);
+            first = construct_segment(start, first, first_segment);
+            head_ = Index::advance(head_, first_segment);
+            construct_segment(0, first, count - first_segment);
+            head_ = Index::advance(head_, count - first_segment);
         }
 
-        const_iterator end() const
+        template <typename ForwardIt>
+        ForwardIt construct_segment(std::size_t slot, ForwardIt first, std::size_t count)
         {
-            return const_iterator(this, head_, size());
+            typedef typename std::iterator_traits<ForwardIt>::value_type source_type;
+            if constexpr (std::is_pointer<ForwardIt>::value && std::is_trivially_copyable<T>::value &&
+                          std::is_same<typename std::remove_cv<source_type>::type, T>::value)
+            {
+                if (count != 0)
+                {
+                    std::memcpy(static_cast<void *>(buffer_.data() + slot), first, count * sizeof(T));
+                }
+                return first + count;
+            }
+            else
+            {
+                std::uninitialized_copy_n(first, count, buffer_.data() + slot);
+                std::advance(first, count);
+                return first;
+            }
         }
 
-        const_iterator cbegin() const
+        template <typename OutputIt>
+        static OutputIt copy_segment(const T *source, std::size_t count, OutputIt dest)
         {
-            return const_iterator(this, tail_, 0);
+            if constexpr (std::is_pointer<OutputIt>::value && std::is_trivially_copyable<T>::value &&
+                          std::is_same<typename std::iterator_traits<OutputIt>::value_type, T>::value)
+            {
+                if (count != 0)
+                {
+                    std::memcpy(static_cast<void *>(dest), source, count * sizeof(T));
+                }
+                return dest + count;
+            }
+            else
+            {
+                return std::copy_n(source, count, dest);
+            }
         }
 
-        const_iterator cend() const
+        static constexpr bool constant_evaluated()
         {
-            return const_iterator(this, head_, size());
+#if CXXCIRCULARBUFFER_CONSTEXPR_STORAGE
+            return std::is_constant_evaluated();
+#else
+            return false;
+#endif
         }
 
-        const_reverse_iterator rbegin() const
+        // Copies the (at most two) segments holding the elements of other into
+        // the same slots, leaving the free slots alone
+        void copy_live_segments(const CircularBuffer &other)
         {
-            std::size_t last_index = (head_ == 0) ? Size - 1 : head_ - 1;
-            return const_reverse_iterator(this, last_index, 0);
+            const std::size_t start = Index::slot(other.tail_);
+            const std::size_t used = other.size();
+            const std::size_t first_segment = std::min(used, Size - start);
+            if (first_segment != 0)
+            {
+                std::memcpy(static_cast<void *>(buffer_.data() + start), other.buffer_.data() + start,
+                            first_segment * sizeof(T));
+            }
+            if (used != first_segment)
+            {
+                std::memcpy(static_cast<void *>(buffer_.data()), other.buffer_.data(),
+                            (used - first_segment) * sizeof(T));
+            }
+            head_ = other.head_;
+            tail_ = other.tail_;
         }
 
-        const_reverse_iterator rend() const
+        // Runs fill, which constructs elements into the empty buffer, and
+        // destroys the ones it constructed if it throws
+        template <typename Fill>
+        void fill_or_clear(Fill fill)
         {
-            std::size_t before_tail = (tail_ == 0) ? Size - 1 : tail_ - 1;
-            return const_reverse_iterator(this, before_tail, size());
+            try
+            {
+                fill();
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
         }
 
-        const_reverse_iterator crbegin() const
+        // Constructs copies of the elements of other in the same slots. The
+        // buffer must be empty; head_ follows each constructed element, so a
+        // throwing copy leaves a valid, partially filled buffer.
+        constexpr void copy_elements_from(const CircularBuffer &other)
         {
-            std::size_t last_index = (head_ == 0) ? Size - 1 : head_ - 1;
-            return const_reverse_iterator(this, last_index, 0);
+            if constexpr (std::is_trivially_copyable<T>::value)
+            {
+                if (!constant_evaluated())
+                {
+                    copy_live_segments(other);
+                    return;
+                }
+            }
+            head_ = tail_ = other.tail_;
+            while (head_ != other.head_)
+            {
+                const std::size_t slot = Index::slot(head_);
+                buffer_.construct(slot, other.buffer_[slot]);
+                head_ = Index::advance(head_, 1);
+            }
         }
 
-        const_reverse_iterator crend() const
+        constexpr void move_elements_from(CircularBuffer &other)
         {
-            std::size_t before_tail = (tail_ == 0) ? Size - 1 : tail_ - 1;
-            return const_reverse_iterator(this, before_tail, size());
+            if constexpr (std::is_trivially_copyable<T>::value)
+            {
+                if (!constant_evaluated())
+                {
+                    copy_live_segments(other);
+                    return;
+                }
+            }
+            head_ = tail_ = other.tail_;
+            while (head_ != other.head_)
+            {
+                const std::size_t slot = Index::slot(head_);
+                buffer_.construct(slot, std::move(other.buffer_[slot]));
+                head_ = Index::advance(head_, 1);
+            }
         }
     };
 } // namespace CXXCircularBuffer
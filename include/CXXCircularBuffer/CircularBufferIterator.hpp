@@ -0,0 +1,138 @@
+#ifndef CXXCIRCULARBUFFER_CIRCULARBUFFERITERATOR_HPP
+#define CXXCIRCULARBUFFER_CIRCULARBUFFERITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace CXXCircularBuffer
+{
+    namespace detail
+    {
+        // Random access const iterator shared by the ring buffers. Buffer must
+        // befriend it and provide slot(index), the element stored in a slot, and
+        // step(index, n), the slot index n positions away (-capacity <= n <=
+        // capacity). A reverse iterator walks the slots backwards.
+        template <typename Buffer, bool Reverse>
+        class RingIterator
+        {
+        private:
+            const Buffer *buffer_;
+            std::size_t index_;
+            std::size_t position_;
+
+            constexpr std::size_t moved(std::ptrdiff_t n) const
+            {
+                return buffer_->step(index_, Reverse ? -n : n);
+            }
+
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef typename Buffer::value_type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef const value_type *pointer;
+            typedef const value_type &reference;
+
+            constexpr RingIterator() : buffer_(nullptr), index_(0), position_(0) {}
+
+            constexpr RingIterator(const Buffer *buf, std::size_t idx, std::size_t pos)
+                : buffer_(buf), index_(idx), position_(pos) {}
+
+            constexpr reference operator*() const { return buffer_->slot(index_); }
+            constexpr pointer operator->() const { return &buffer_->slot(index_); }
+
+            constexpr RingIterator &operator++()
+            {
+                index_ = moved(1);
+                ++position_;
+                return *this;
+            }
+
+            constexpr RingIterator operator++(int)
+            {
+                RingIterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            constexpr RingIterator &operator--()
+            {
+                index_ = moved(-1);
+                --position_;
+                return *this;
+            }
+
+            constexpr RingIterator operator--(int)
+            {
+                RingIterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            constexpr RingIterator &operator+=(difference_type n)
+            {
+                position_ += n;
+                index_ = moved(n);
+                return *this;
+            }
+
+            constexpr RingIterator &operator-=(difference_type n)
+            {
+                return *this += (-n);
+            }
+
+            constexpr RingIterator operator+(difference_type n) const
+            {
+                RingIterator tmp = *this;
+                return tmp += n;
+            }
+
+            constexpr RingIterator operator-(difference_type n) const
+            {
+                RingIterator tmp = *this;
+                return tmp -= n;
+            }
+
+            constexpr difference_type operator-(const RingIterator &other) const
+            {
+                return position_ - other.position_;
+            }
+
+            constexpr reference operator[](difference_type n) const
+            {
+                return *(*this + n);
+            }
+
+            constexpr bool operator==(const RingIterator &other) const
+            {
+                return buffer_ == other.buffer_ && position_ == other.position_;
+            }
+
+            constexpr bool operator!=(const RingIterator &other) const
+            {
+                return !(*this == other);
+            }
+
+            constexpr bool operator<(const RingIterator &other) const
+            {
+                return position_ < other.position_;
+            }
+
+            constexpr bool operator>(const RingIterator &other) const
+            {
+                return other < *this;
+            }
+
+            constexpr bool operator<=(const RingIterator &other) const
+            {
+                return !(other < *this);
+            }
+
+            constexpr bool operator>=(const RingIterator &other) const
+            {
+                return !(*this < other);
+            }
+        };
+    } // namespace detail
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_CIRCULARBUFFERITERATOR_HPP
@@ -0,0 +1,204 @@
+#ifndef CXXCIRCULARBUFFER_COMMON_HPP
+#define CXXCIRCULARBUFFER_COMMON_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Set when a constexpr constructor may leave members uninitialized (C++20),
+// which lets rings be built in constant expressions without initializing
+// their slots at run time
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L && defined(__cpp_lib_is_constant_evaluated)
+#define CXXCIRCULARBUFFER_CONSTEXPR_STORAGE 1
+#else
+#define CXXCIRCULARBUFFER_CONSTEXPR_STORAGE 0
+#endif
+
+namespace CXXCircularBuffer
+{
+    namespace detail
+    {
+        // Assumed destructive interference size, used to keep indices written
+        // by different threads on different cache lines
+        constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        constexpr bool is_power_of_two(std::size_t n)
+        {
+            return n != 0 && (n & (n - 1)) == 0;
+        }
+
+        // Hint for the body of a spin loop: lets the sibling hyper-thread run and
+        // avoids the memory order violation penalty when the loop exits
+        inline void cpu_relax() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        // Index arithmetic of a ring with Size slots. head and tail are kept as
+        // counters over [0, 2 * Size), so a full ring (distance Size) can be told
+        // apart from an empty one without a flag, and every wrap is a compare and
+        // subtract instead of an integer division.
+        template <std::size_t Size, bool PowerOfTwo = is_power_of_two(Size)>
+        struct RingIndex
+        {
+            static constexpr std::size_t Period = 2 * Size;
+
+            static constexpr std::size_t slot(std::size_t counter)
+            {
+                return counter < Size ? counter : counter - Size;
+            }
+
+            // n <= Period
+            static constexpr std::size_t advance(std::size_t counter, std::size_t n)
+            {
+                counter += n;
+                return counter >= Period ? counter - Period : counter;
+            }
+
+            // n <= Period
+            static constexpr std::size_t retreat(std::size_t counter, std::size_t n)
+            {
+                return counter >= n ? counter - n : counter + Period - n;
+            }
+
+            static constexpr std::size_t distance(std::size_t from, std::size_t to)
+            {
+                return to >= from ? to - from : to + Period - from;
+            }
+
+            // Moves a slot index by n positions, -Size <= n <= Size
+            static constexpr std::size_t step(std::size_t slot, std::ptrdiff_t n)
+            {
+                const std::ptrdiff_t moved = static_cast<std::ptrdiff_t>(slot) + n;
+                if (moved < 0)
+                {
+                    return static_cast<std::size_t>(moved + static_cast<std::ptrdiff_t>(Size));
+                }
+                return static_cast<std::size_t>(moved) >= Size ? static_cast<std::size_t>(moved) - Size
+                                                               : static_cast<std::size_t>(moved);
+            }
+        };
+
+        // Power-of-two rings use free-running counters: a slot is a mask and the
+        // distance between counters is a plain subtraction
+        template <std::size_t Size>
+        struct RingIndex<Size, true>
+        {
+            static constexpr std::size_t Mask = Size - 1;
+
+            static constexpr std::size_t slot(std::size_t counter)
+            {
+                return counter & Mask;
+            }
+
+            static constexpr std::size_t advance(std::size_t counter, std::size_t n)
+            {
+                return counter + n;
+            }
+
+            static constexpr std::size_t retreat(std::size_t counter, std::size_t n)
+            {
+                return counter - n;
+            }
+
+            static constexpr std::size_t distance(std::size_t from, std::size_t to)
+            {
+                return to - from;
+            }
+
+            static constexpr std::size_t step(std::size_t slot, std::ptrdiff_t n)
+            {
+                return (slot + static_cast<std::size_t>(n)) & Mask;
+            }
+        };
+
+        // Array of N slots of T that are not constructed up front. The owner is
+        // responsible for constructing and destroying each slot.
+        template <typename T, std::size_t N>
+        class UninitializedArray
+        {
+        private:
+            union
+            {
+                T data_[N];
+            };
+
+        public:
+            UninitializedArray() noexcept {}
+
+            ~UninitializedArray() {}
+
+            UninitializedArray(const UninitializedArray &) = delete;
+            UninitializedArray &operator=(const UninitializedArray &) = delete;
+
+            T *data() noexcept { return data_; }
+            const T *data() const noexcept { return data_; }
+
+            T &operator[](std::size_t index) noexcept { return data_[index]; }
+            const T &operator[](std::size_t index) const noexcept { return data_[index]; }
+
+            template <typename... Args>
+            T &construct(std::size_t index, Args &&...args)
+            {
+                return *::new (static_cast<void *>(data_ + index)) T(std::forward<Args>(args)...);
+            }
+
+            void destroy(std::size_t index) noexcept
+            {
+                data_[index].~T();
+            }
+        };
+
+        // Same interface as UninitializedArray for trivial types, whose slots
+        // can simply be assigned. The slots are left uninitialized at run time.
+        // Constant evaluation cannot read an uninitialized object, so there
+        // they are zeroed, which needs C++20; in C++17 the array cannot be
+        // constructed in a constant expression.
+        template <typename T, std::size_t N>
+        class TrivialArray
+        {
+            static_assert(std::is_trivial<T>::value, "TrivialArray requires a trivial type");
+
+        private:
+            T data_[N];
+
+        public:
+#if CXXCIRCULARBUFFER_CONSTEXPR_STORAGE
+            constexpr TrivialArray() noexcept
+            {
+                if (std::is_constant_evaluated())
+                {
+                    for (std::size_t index = 0; index != N; ++index)
+                    {
+                        data_[index] = T();
+                    }
+                }
+            }
+#else
+            TrivialArray() = default;
+#endif
+
+            constexpr T *data() noexcept { return data_; }
+            constexpr const T *data() const noexcept { return data_; }
+
+            constexpr T &operator[](std::size_t index) noexcept { return data_[index]; }
+            constexpr const T &operator[](std::size_t index) const noexcept { return data_[index]; }
+
+            template <typename... Args>
+            constexpr T &construct(std::size_t index, Args &&...args)
+            {
+                data_[index] = T(std::forward<Args>(args)...);
+                return data_[index];
+            }
+
+            constexpr void destroy(std::size_t) noexcept {}
+        };
+    } // namespace detail
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_COMMON_HPP
@@ -0,0 +1,857 @@
+#ifndef CXXCIRCULARBUFFER_DYNAMICCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_DYNAMICCIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/CircularBufferIterator.hpp>
+#include <CXXCircularBuffer/OverflowPolicy.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+#include <CXXCircularBuffer/Statistics.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    // CircularBuffer with a capacity chosen at run time and storage obtained
+    // from Allocator. It offers the same operations and iterators as
+    // CircularBuffer, plus set_capacity() and resize() to change the capacity
+    // of a live buffer. Policy decides what a push into a full buffer does;
+    // see OverflowPolicy. Instrumented enables the counters returned by
+    // statistics().
+    template <typename T, typename Allocator = std::allocator<T>,
+              OverflowPolicy Policy = OverflowPolicy::OverwriteOldest, bool Instrumented = false>
+    class DynamicCircularBuffer : private detail::StatisticsCounters<Instrumented>
+    {
+        static_assert(Policy != OverflowPolicy::Block,
+                      "nothing else can make room in a single-threaded buffer: use BlockingCircularBuffer");
+
+    private:
+        typedef std::allocator_traits<Allocator> AllocTraits;
+        typedef detail::StatisticsCounters<Instrumented> Counters;
+
+        static_assert(std::is_same<typename AllocTraits::value_type, T>::value,
+                      "Allocator::value_type must be T");
+        static_assert(std::is_same<typename AllocTraits::pointer, T *>::value,
+                      "Allocators with fancy pointers are not supported");
+
+        Allocator allocator_;
+        T *buffer_ = nullptr;
+        std::size_t capacity_ = 0;
+        // Counters over [0, 2 * capacity_), as in detail::RingIndex
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef detail::RingIterator<DynamicCircularBuffer, false> const_iterator;
+        typedef const_iterator CircularBufferIterator;
+        typedef detail::RingIterator<DynamicCircularBuffer, true> const_reverse_iterator;
+
+        explicit DynamicCircularBuffer(const Allocator &allocator = Allocator()) : allocator_(allocator) {}
+
+        explicit DynamicCircularBuffer(size_type capacity, const Allocator &allocator = Allocator())
+            : allocator_(allocator)
+        {
+            buffer_ = allocate(capacity);
+            capacity_ = capacity;
+        }
+
+        DynamicCircularBuffer(const DynamicCircularBuffer &other)
+            : Counters(), allocator_(AllocTraits::select_on_container_copy_construction(other.allocator_))
+        {
+            buffer_ = allocate(other.capacity_);
+            capacity_ = other.capacity_;
+            try
+            {
+                copy_elements_from(other);
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        DynamicCircularBuffer(DynamicCircularBuffer &&other) noexcept
+            : Counters(), allocator_(std::move(other.allocator_)),
+              buffer_(std::exchange(other.buffer_, nullptr)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              head_(std::exchange(other.head_, 0)),
+              tail_(std::exchange(other.tail_, 0))
+        {
+        }
+
+        DynamicCircularBuffer &operator=(const DynamicCircularBuffer &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (AllocTraits::propagate_on_container_copy_assignment::value && allocator_ != other.allocator_)
+                {
+                    release();
+                    allocator_ = other.allocator_;
+                }
+                if (capacity_ != other.capacity_)
+                {
+                    release();
+                    buffer_ = allocate(other.capacity_);
+                    capacity_ = other.capacity_;
+                }
+                copy_elements_from(other);
+            }
+            return *this;
+        }
+
+        DynamicCircularBuffer &operator=(DynamicCircularBuffer &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+            if (AllocTraits::propagate_on_container_move_assignment::value || allocator_ == other.allocator_)
+            {
+                release();
+                if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                {
+                    allocator_ = std::move(other.allocator_);
+                }
+                buffer_ = std::exchange(other.buffer_, nullptr);
+                capacity_ = std::exchange(other.capacity_, 0);
+                head_ = std::exchange(other.head_, 0);
+                tail_ = std::exchange(other.tail_, 0);
+            }
+            else
+            {
+                // Storage from another allocator cannot be adopted, move the
+                // elements one by one instead
+                clear();
+                if (capacity_ != other.capacity_)
+                {
+                    release();
+                    buffer_ = allocate(other.capacity_);
+                    capacity_ = other.capacity_;
+                }
+                move_elements_from(other);
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~DynamicCircularBuffer()
+        {
+            release();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_;
+        }
+
+        size_type size() const
+        {
+            return distance(tail_, head_);
+        }
+
+        size_type capacity() const
+        {
+            return capacity_;
+        }
+
+        size_type max_size() const
+        {
+            return capacity_;
+        }
+
+        bool empty() const
+        {
+            return head_ == tail_;
+        }
+
+        bool full() const
+        {
+            return size() == capacity_;
+        }
+
+        // Changes the capacity, keeping the newest elements when the buffer
+        // shrinks below its size. The elements are moved to the new storage
+        // in one pass and end up contiguous, starting at the first slot.
+        void set_capacity(size_type new_capacity)
+        {
+            if (new_capacity == capacity_)
+            {
+                return;
+            }
+            T *storage = allocate(new_capacity);
+            const std::size_t kept = std::min(size(), new_capacity);
+            std::size_t counter = retreat(head_, kept);
+            std::size_t moved = 0;
+            try
+            {
+                for (; moved < kept; ++moved, counter = advance(counter, 1))
+                {
+                    AllocTraits::construct(allocator_, storage + moved, std::move_if_noexcept(buffer_[slot_of(counter)]));
+                }
+            }
+            catch (...)
+            {
+                for (std::size_t i = 0; i < moved; ++i)
+                {
+                    AllocTraits::destroy(allocator_, storage + i);
+                }
+                AllocTraits::deallocate(allocator_, storage, new_capacity);
+                throw;
+            }
+            release();
+            buffer_ = storage;
+            capacity_ = new_capacity;
+            tail_ = 0;
+            head_ = kept;
+            update_full();
+        }
+
+        // Changes the number of elements: grows the capacity if needed and
+        // appends copies of value, or removes the newest elements
+        void resize(size_type new_size, const T &value = T())
+        {
+            if (new_size > capacity_)
+            {
+                set_capacity(new_size);
+            }
+            while (size() < new_size)
+            {
+                push_back(value);
+            }
+            while (size() > new_size)
+            {
+                head_ = retreat(head_, 1);
+                AllocTraits::destroy(allocator_, buffer_ + slot_of(head_));
+            }
+            update_full();
+        }
+
+        reference front()
+        {
+            return buffer_[slot_of(tail_)];
+        }
+
+        reference back()
+        {
+            return buffer_[slot_of(retreat(head_, 1))];
+        }
+
+        const_reference front() const
+        {
+            return buffer_[slot_of(tail_)];
+        }
+
+        const_reference back() const
+        {
+            return buffer_[slot_of(retreat(head_, 1))];
+        }
+
+        void clear()
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (std::size_t counter = tail_; counter != head_; counter = advance(counter, 1))
+                {
+                    AllocTraits::destroy(allocator_, buffer_ + slot_of(counter));
+                }
+            }
+            head_ = tail_ = 0;
+            this->record_not_full();
+        }
+
+        // Follows Policy when the buffer is full; try_push_back() tells what
+        // happened. A buffer with no capacity drops every pushed element.
+        void push_back(const T &item)
+        {
+            emplace_value(item);
+        }
+
+        void push_back(T &&item)
+        {
+            emplace_value(std::move(item));
+        }
+
+        PushStatus try_push_back(const T &item)
+        {
+            return emplace_value(item);
+        }
+
+        PushStatus try_push_back(T &&item)
+        {
+            return emplace_value(std::move(item));
+        }
+
+        // When the buffer is full the oldest element is replaced by a temporary
+        // built from args. Throws std::length_error if capacity() is 0, as
+        // there is no element to return.
+        template <typename... Args>
+        reference emplace_back(Args &&...args)
+        {
+            static_assert(Policy == OverflowPolicy::OverwriteOldest,
+                          "emplace_back always stores the element: use try_emplace_back");
+            return emplace_unchecked(std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        PushStatus try_emplace_back(Args &&...args)
+        {
+            if (capacity_ == 0)
+            {
+                this->record_rejection(1);
+                return overflow_status();
+            }
+            if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+            {
+                const bool overwrite = full();
+                emplace_unchecked(std::forward<Args>(args)...);
+                return overwrite ? PushStatus::Overwritten : PushStatus::Pushed;
+            }
+            else
+            {
+                if (full())
+                {
+                    this->record_rejection(1);
+                    return overflow_status();
+                }
+                emplace_unchecked(std::forward<Args>(args)...);
+                return PushStatus::Pushed;
+            }
+        }
+
+
+        void pop_front()
+        {
+            if (!empty())
+            {
+                AllocTraits::destroy(allocator_, buffer_ + slot_of(tail_));
+                tail_ = advance(tail_, 1);
+                popped(1);
+            }
+        }
+
+        bool pop_front(T &item)
+        {
+            if (empty())
+            {
+                return false;
+            }
+            T *element = buffer_ + slot_of(tail_);
+            item = std::move(*element);
+            AllocTraits::destroy(allocator_, element);
+            tail_ = advance(tail_, 1);
+            popped(1);
+            return true;
+        }
+
+        // Destroys the newest element
+        void pop_back()
+        {
+            if (!empty())
+            {
+                head_ = retreat(head_, 1);
+                AllocTraits::destroy(allocator_, buffer_ + slot_of(head_));
+                popped(1);
+            }
+        }
+
+        // Appends [first, last) as if by push_back for every element: with
+        // OverwriteOldest only the last capacity() elements are kept, with the
+        // other policies only the elements that fit. Returns the number of
+        // elements of the range now stored in the buffer, as CircularBuffer
+        // does.
+        template <typename InputIt,
+                  typename Category = typename std::iterator_traits<InputIt>::iterator_category>
+        size_type push_back(InputIt first, InputIt last)
+        {
+            if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+            {
+                const std::size_t total = static_cast<std::size_t>(std::distance(first, last));
+                std::size_t count = total;
+                if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+                {
+                    if (capacity_ == 0)
+                    {
+                        this->record_rejection(total);
+                        return 0;
+                    }
+                    const std::size_t used = size();
+                    if (used + total > capacity_)
+                    {
+                        this->record_overwrite(used + total - capacity_);
+                    }
+                    if (count > capacity_)
+                    {
+                        clear();
+                        std::advance(first, count - capacity_);
+                        count = capacity_;
+                    }
+                    append_n(first, count);
+                    pushed(total);
+                }
+                else
+                {
+                    count = std::min(count, capacity_ - size());
+                    if (count != total)
+                    {
+                        this->record_rejection(total - count);
+                    }
+                    append_n(first, count);
+                    pushed(count);
+                }
+                return count;
+            }
+            else
+            {
+                std::size_t count = 0;
+                for (; first != last; ++first)
+                {
+                    if (stored(emplace_value(*first)))
+                    {
+                        ++count;
+                    }
+                }
+                return std::min(count, capacity_);
+            }
+        }
+
+        size_type push_back(Span<const T> items)
+        {
+            return push_back(items.begin(), items.end());
+        }
+
+        size_type pop_front_n(size_type count)
+        {
+            count = std::min(count, size());
+            destroy_front(count);
+            popped(count);
+            return count;
+        }
+
+        template <typename OutputIt>
+        size_type copy_out(OutputIt dest, size_type count) const
+        {
+            count = std::min(count, size());
+            const std::size_t start = slot_of(tail_);
+            const std::size_t first_segment = std::min(count, capacity_ - start);
+            dest = copy_segment(buffer_ + start, first_segment, dest);
+            copy_segment(buffer_, count - first_segment, dest);
+            return count;
+        }
+
+        Span<T> array_one()
+        {
+            const std::size_t start = slot_of(tail_);
+            return Span<T>(buffer_ + start, std::min(size(), capacity_ - start));
+        }
+
+        Span<T> array_two()
+        {
+            const std::size_t start = slot_of(tail_);
+            const std::size_t used = size();
+            return Span<T>(buffer_, used - std::min(used, capacity_ - start));
+        }
+
+        Span<const T> array_one() const
+        {
+            const std::size_t start = slot_of(tail_);
+            return Span<const T>(buffer_ + start, std::min(size(), capacity_ - start));
+        }
+
+        Span<const T> array_two() const
+        {
+            const std::size_t start = slot_of(tail_);
+            const std::size_t used = size();
+            return Span<const T>(buffer_, used - std::min(used, capacity_ - start));
+        }
+
+        Span<T> free_array_one()
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            const std::size_t start = slot_of(head_);
+            return Span<T>(buffer_ + start, std::min(capacity_ - size(), capacity_ - start));
+        }
+
+        Span<T> free_array_two()
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            const std::size_t start = slot_of(head_);
+            const std::size_t available = capacity_ - size();
+            return Span<T>(buffer_, available - std::min(available, capacity_ - start));
+        }
+
+        void commit(size_type count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            count = std::min(count, capacity_ - size());
+            head_ = advance(head_, count);
+            pushed(count);
+        }
+
+        // When fewer than count slots are free, OverwriteOldest evicts the
+        // oldest elements; the other policies return only the free slots
+        Segments<T> reserve(size_type count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            count = std::min(count, capacity_);
+            const size_type available = capacity_ - size();
+            if (count > available)
+            {
+                if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+                {
+                    destroy_front(count - available);
+                    this->record_overwrite(count - available);
+                }
+                else
+                {
+                    count = available;
+                }
+            }
+            const std::size_t start = slot_of(head_);
+            const std::size_t first_segment = std::min(count, capacity_ - start);
+            return Segments<T>{Span<T>(buffer_ + start, first_segment), Span<T>(buffer_, count - first_segment)};
+        }
+
+        Segments<T> peek(size_type count)
+        {
+            count = std::min(count, size());
+            const std::size_t start = slot_of(tail_);
+            const std::size_t first_segment = std::min(count, capacity_ - start);
+            return Segments<T>{Span<T>(buffer_ + start, first_segment), Span<T>(buffer_, count - first_segment)};
+        }
+
+        Segments<const T> peek(size_type count) const
+        {
+            count = std::min(count, size());
+            const std::size_t start = slot_of(tail_);
+            const std::size_t first_segment = std::min(count, capacity_ - start);
+            return Segments<const T>{Span<const T>(buffer_ + start, first_segment),
+                                     Span<const T>(buffer_, count - first_segment)};
+        }
+
+        size_type consume(size_type count)
+        {
+            return pop_front_n(count);
+        }
+
+        BufferStatistics statistics() const
+        {
+            static_assert(Instrumented, "statistics require DynamicCircularBuffer<T, Allocator, Policy, true>");
+            return Counters::statistics();
+        }
+
+        void reset_statistics()
+        {
+            static_assert(Instrumented, "statistics require DynamicCircularBuffer<T, Allocator, Policy, true>");
+            Counters::reset_statistics();
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return buffer_[slot_of(advance(tail_, index))];
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, slot_of(tail_), 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, slot_of(head_), size());
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(this, slot_of(retreat(head_, 1)), 0);
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(this, slot_of(retreat(tail_, 1)), size());
+        }
+
+        const_reverse_iterator crbegin() const
+        {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const
+        {
+            return rend();
+        }
+
+    private:
+        template <typename, bool>
+        friend class detail::RingIterator;
+
+        const_reference slot(std::size_t index) const
+        {
+            return buffer_[index];
+        }
+
+        std::size_t step(std::size_t index, std::ptrdiff_t n) const
+        {
+            const std::ptrdiff_t moved = static_cast<std::ptrdiff_t>(index) + n;
+            if (moved < 0)
+            {
+                return static_cast<std::size_t>(moved + static_cast<std::ptrdiff_t>(capacity_));
+            }
+            return static_cast<std::size_t>(moved) >= capacity_ ? static_cast<std::size_t>(moved) - capacity_
+                                                                : static_cast<std::size_t>(moved);
+        }
+
+        std::size_t slot_of(std::size_t counter) const
+        {
+            return counter < capacity_ ? counter : counter - capacity_;
+        }
+
+        std::size_t advance(std::size_t counter, std::size_t n) const
+        {
+            counter += n;
+            return counter >= 2 * capacity_ ? counter - 2 * capacity_ : counter;
+        }
+
+        std::size_t retreat(std::size_t counter, std::size_t n) const
+        {
+            return counter >= n ? counter - n : counter + 2 * capacity_ - n;
+        }
+
+        std::size_t distance(std::size_t from, std::size_t to) const
+        {
+            return to >= from ? to - from : to + 2 * capacity_ - from;
+        }
+
+        T *allocate(std::size_t capacity)
+        {
+            return capacity == 0 ? nullptr : AllocTraits::allocate(allocator_, capacity);
+        }
+
+        // Destroys the elements and gives the storage back to the allocator
+        void release()
+        {
+            clear();
+            if (buffer_ != nullptr)
+            {
+                AllocTraits::deallocate(allocator_, buffer_, capacity_);
+                buffer_ = nullptr;
+            }
+            capacity_ = 0;
+        }
+
+        void pushed(std::size_t count)
+        {
+            this->record_push(count, size());
+            if (full())
+            {
+                this->record_full();
+            }
+        }
+
+        void popped(std::size_t count)
+        {
+            this->record_pop(count);
+            this->record_not_full();
+        }
+
+        // After a change of capacity or size that is neither a push nor a pop
+        void update_full()
+        {
+            if (full())
+            {
+                this->record_full();
+            }
+            else
+            {
+                this->record_not_full();
+            }
+        }
+
+        // Destroys the count <= size() oldest elements
+        void destroy_front(std::size_t count)
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    AllocTraits::destroy(allocator_, buffer_ + slot_of(advance(tail_, i)));
+                }
+            }
+            tail_ = advance(tail_, count);
+        }
+
+        // Also the outcome of any push into a buffer with no capacity
+        static constexpr PushStatus overflow_status()
+        {
+            return Policy == OverflowPolicy::RejectNew ? PushStatus::Rejected : PushStatus::Dropped;
+        }
+
+        // Overwriting a full buffer assigns over the oldest element, so types
+        // such as std::string can reuse the storage they already own
+        template <typename U>
+        PushStatus emplace_value(U &&item)
+        {
+            const std::size_t slot = slot_of(head_);
+            if (!full())
+            {
+                AllocTraits::construct(allocator_, buffer_ + slot, std::forward<U>(item));
+                head_ = advance(head_, 1);
+                pushed(1);
+                return PushStatus::Pushed;
+            }
+            if constexpr (Policy == OverflowPolicy::OverwriteOldest)
+            {
+                if (capacity_ != 0)
+                {
+                    buffer_[slot] = std::forward<U>(item);
+                    tail_ = advance(tail_, 1);
+                    head_ = advance(head_, 1);
+                    this->record_overwrite(1);
+                    pushed(1);
+                    return PushStatus::Overwritten;
+                }
+            }
+            this->record_rejection(1);
+            return overflow_status();
+        }
+
+        // Stores the new element whatever the policy, overwriting the oldest
+        template <typename... Args>
+        reference emplace_unchecked(Args &&...args)
+        {
+            if (capacity_ == 0)
+            {
+                throw std::length_error("DynamicCircularBuffer has no capacity");
+            }
+            const std::size_t slot = slot_of(head_);
+            if (full())
+            {
+                buffer_[slot] = T(std::forward<Args>(args)...);
+                tail_ = advance(tail_, 1);
+                this->record_overwrite(1);
+            }
+            else
+            {
+                AllocTraits::construct(allocator_, buffer_ + slot, std::forward<Args>(args)...);
+            }
+            head_ = advance(head_, 1);
+            pushed(1);
+            return buffer_[slot];
+        }
+
+        template <typename ForwardIt>
+        void append_n(ForwardIt first, std::size_t count)
+        {
+            const std::size_t used = size();
+            if (used + count > capacity_)
+            {
+                destroy_front(used + count - capacity_);
+            }
+            const std::size_t start = slot_of(head_);
+            const std::size_t first_segment = std::min(count, capacity_ - start);
+            first = construct_segment(start, first, first_segment);
+            construct_segment(0, first, count - first_segment);
+        }
+
+        // Constructs count elements from first at slot, moving head_ along so
+        // that a throwing constructor leaves a consistent buffer
+        template <typename ForwardIt>
+        ForwardIt construct_segment(std::size_t slot, ForwardIt first, std::size_t count)
+        {
+            typedef typename std::iterator_traits<ForwardIt>::value_type source_type;
+            if constexpr (std::is_pointer<ForwardIt>::value && std::is_trivially_copyable<T>::value &&
+                          std::is_same<typename std::remove_cv<source_type>::type, T>::value)
+            {
+                if (count != 0)
+                {
+                    std::memcpy(static_cast<void *>(buffer_ + slot), first, count * sizeof(T));
+                }
+                head_ = advance(head_, count);
+                return first + count;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i, ++first)
+                {
+                    AllocTraits::construct(allocator_, buffer_ + slot + i, *first);
+                    head_ = advance(head_, 1);
+                }
+                return first;
+            }
+        }
+
+        template <typename OutputIt>
+        static OutputIt copy_segment(const T *source, std::size_t count, OutputIt dest)
+        {
+            if constexpr (std::is_pointer<OutputIt>::value && std::is_trivially_copyable<T>::value &&
+                          std::is_same<typename std::iterator_traits<OutputIt>::value_type, T>::value)
+            {
+                if (count != 0)
+                {
+                    std::memcpy(static_cast<void *>(dest), source, count * sizeof(T));
+                }
+                return dest + count;
+            }
+            else
+            {
+                return std::copy_n(source, count, dest);
+            }
+        }
+
+        // Both buffers must have the same capacity and this one must be empty
+        void copy_elements_from(const DynamicCircularBuffer &other)
+        {
+            head_ = tail_ = other.tail_;
+            while (head_ != other.head_)
+            {
+                const std::size_t slot = slot_of(head_);
+                AllocTraits::construct(allocator_, buffer_ + slot, other.buffer_[slot]);
+                head_ = advance(head_, 1);
+            }
+        }
+
+        void move_elements_from(DynamicCircularBuffer &other)
+        {
+            head_ = tail_ = other.tail_;
+            while (head_ != other.head_)
+            {
+                const std::size_t slot = slot_of(head_);
+                AllocTraits::construct(allocator_, buffer_ + slot, std::move(other.buffer_[slot]));
+                head_ = advance(head_, 1);
+            }
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_DYNAMICCIRCULARBUFFER_HPP
@@ -0,0 +1,384 @@
+#ifndef CXXCIRCULARBUFFER_MPMCCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_MPMCCIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/Statistics.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    // Bounded lock-free ring for any number of producer and consumer threads.
+    // Every slot carries a sequence number telling whether it is ready to be
+    // written or read for a given lap (D. Vyukov's bounded MPMC queue), so
+    // producers and consumers only contend on their own position counter.
+    // Like SPSCCircularBuffer it never overwrites: enqueueing into a full
+    // buffer fails. Instrumented enables the counters returned by statistics().
+    template <typename T, size_t Size, bool Instrumented = false>
+    class MPMCCircularBuffer : private detail::StatisticsCounters<Instrumented, true>
+    {
+        static_assert(Size >= 2, "MPMCCircularBuffer capacity must be at least 2");
+
+    private:
+        typedef detail::StatisticsCounters<Instrumented, true> Counters;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence_;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+
+            T *value() { return std::launder(reinterpret_cast<T *>(&storage_)); }
+        };
+
+        alignas(detail::CACHE_LINE_SIZE) Cell cells_[Size];
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_pos_{0};
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_pos_{0};
+
+        Cell *cell(std::size_t pos)
+        {
+            if constexpr (detail::is_power_of_two(Size))
+            {
+                return &cells_[pos & (Size - 1)];
+            }
+            else
+            {
+                return &cells_[pos % Size];
+            }
+        }
+
+        static std::intptr_t lag(std::size_t sequence, std::size_t pos)
+        {
+            return static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        }
+
+        // The size is only computed when statistics are enabled
+        void pushed(std::size_t count)
+        {
+            if constexpr (Instrumented)
+            {
+                this->record_push(count, size());
+                this->record_not_full();
+            }
+        }
+
+        void rejected(std::size_t count)
+        {
+            this->record_rejection(count);
+            this->record_full();
+        }
+
+        // Claims the cell at the consumer position, or returns nullptr when
+        // nothing has been published there for the current lap yet
+        Cell *claim_dequeue(std::size_t &pos)
+        {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell *source = cell(pos);
+                const std::intptr_t diff = lag(source->sequence_.load(std::memory_order_acquire), pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        return source;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    public:
+        typedef T value_type;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+
+        MPMCCircularBuffer()
+        {
+            for (std::size_t i = 0; i < Size; ++i)
+            {
+                cells_[i].sequence_.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MPMCCircularBuffer()
+        {
+            const std::size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+            for (std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos)
+            {
+                cell(pos)->value()->~T();
+            }
+        }
+
+        MPMCCircularBuffer(const MPMCCircularBuffer &) = delete;
+        MPMCCircularBuffer &operator=(const MPMCCircularBuffer &) = delete;
+
+        // Once a slot is claimed its sequence must be published, or every
+        // consumer stalls on it. A constructor that may throw therefore runs
+        // on a temporary before the claim, which is then moved into the slot.
+        template <typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            if constexpr (std::is_nothrow_constructible<T, Args &&...>::value)
+            {
+                return emplace_claimed(std::forward<Args>(args)...);
+            }
+            else
+            {
+                static_assert(std::is_nothrow_move_constructible<T>::value,
+                              "MPMCCircularBuffer requires a nothrow move constructor to emplace with a throwing one");
+                return emplace_claimed(T(std::forward<Args>(args)...));
+            }
+        }
+
+    private:
+        // Claims a slot and constructs the element from args, which must not throw
+        template <typename... Args>
+        bool emplace_claimed(Args &&...args)
+        {
+            std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Cell *target;
+            for (;;)
+            {
+                target = cell(pos);
+                const std::intptr_t diff = lag(target->sequence_.load(std::memory_order_acquire), pos);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // The slot still holds the element from the previous lap
+                    rejected(1);
+                    return false;
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            ::new (static_cast<void *>(&target->storage_)) T(std::forward<Args>(args)...);
+            target->sequence_.store(pos + 1, std::memory_order_release);
+            pushed(1);
+            return true;
+        }
+
+    public:
+        bool try_enqueue(const T &item)
+        {
+            return try_emplace(item);
+        }
+
+        bool try_enqueue(T &&item)
+        {
+            return try_emplace(std::move(item));
+        }
+
+        // If the move assignment throws, the element is dropped so that its
+        // slot is released
+        bool try_dequeue(T &item)
+        {
+            return try_consume([&item](T &value) { item = std::move(value); });
+        }
+
+        // Zero-copy read: hands the oldest element to reader as T & in its slot
+        // instead of moving it out, then removes it. Returns false when the
+        // buffer is empty. Writing in place is try_emplace().
+        template <typename Reader>
+        bool try_consume(Reader &&reader)
+        {
+            std::size_t pos;
+            Cell *source = claim_dequeue(pos);
+            if (source == nullptr)
+            {
+                return false;
+            }
+            T *value = source->value();
+            try
+            {
+                reader(*value);
+            }
+            catch (...)
+            {
+                // The slot is claimed: it has to be released whatever happens
+                value->~T();
+                source->sequence_.store(pos + Size, std::memory_order_release);
+                this->record_pop(1);
+                throw;
+            }
+            value->~T();
+            source->sequence_.store(pos + Size, std::memory_order_release);
+            this->record_pop(1);
+            return true;
+        }
+
+        // Enqueues up to count elements read from first, claiming all the free
+        // slots found at the producer position with a single CAS. Returns the
+        // number of elements enqueued, which is 0 when the buffer is full.
+        // The claimed slots are filled in place, so copying must not throw.
+        template <typename InputIt>
+        size_type try_enqueue_bulk(InputIt first, size_type count)
+        {
+            static_assert(std::is_nothrow_constructible<T, decltype(*first)>::value,
+                          "try_enqueue_bulk requires elements constructible without throwing");
+            std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            std::size_t ready = 0;
+            for (;;)
+            {
+                ready = 0;
+                while (ready < count && ready < Size &&
+                       lag(cell(pos + ready)->sequence_.load(std::memory_order_acquire), pos + ready) == 0)
+                {
+                    ++ready;
+                }
+                if (ready == 0)
+                {
+                    if (count == 0)
+                    {
+                        return 0;
+                    }
+                    if (lag(cell(pos)->sequence_.load(std::memory_order_acquire), pos) < 0)
+                    {
+                        rejected(count);
+                        return 0;
+                    }
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+                else if (enqueue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            for (std::size_t i = 0; i < ready; ++i, ++first)
+            {
+                Cell *target = cell(pos + i);
+                ::new (static_cast<void *>(&target->storage_)) T(*first);
+                target->sequence_.store(pos + i + 1, std::memory_order_release);
+            }
+            pushed(ready);
+            if (ready < count)
+            {
+                rejected(count - ready);
+            }
+            return ready;
+        }
+
+        // Dequeues up to count elements into out, claiming all the published
+        // slots found at the consumer position with a single CAS. Returns the
+        // number of elements dequeued, which is 0 when the buffer is empty. If
+        // an assignment to out throws, the claimed elements not yet dequeued
+        // are dropped so that their slots are released.
+        template <typename OutputIt>
+        size_type try_dequeue_bulk(OutputIt out, size_type count)
+        {
+            std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            std::size_t ready = 0;
+            for (;;)
+            {
+                ready = 0;
+                while (ready < count && ready < Size &&
+                       lag(cell(pos + ready)->sequence_.load(std::memory_order_acquire), pos + ready + 1) == 0)
+                {
+                    ++ready;
+                }
+                if (ready == 0)
+                {
+                    if (count == 0 || lag(cell(pos)->sequence_.load(std::memory_order_acquire), pos + 1) < 0)
+                    {
+                        return 0;
+                    }
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+                else if (dequeue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            std::size_t i = 0;
+            try
+            {
+                for (; i < ready; ++i, ++out)
+                {
+                    Cell *source = cell(pos + i);
+                    T *value = source->value();
+                    *out = std::move(*value);
+                    value->~T();
+                    source->sequence_.store(pos + i + Size, std::memory_order_release);
+                }
+            }
+            catch (...)
+            {
+                // The slots are claimed: they have to be released whatever happens
+                for (; i < ready; ++i)
+                {
+                    Cell *source = cell(pos + i);
+                    source->value()->~T();
+                    source->sequence_.store(pos + i + Size, std::memory_order_release);
+                }
+                this->record_pop(ready);
+                throw;
+            }
+            this->record_pop(ready);
+            return ready;
+        }
+
+        // Snapshot only: other threads may change the size concurrently
+        size_type size() const
+        {
+            const std::size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+            const std::size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+            const std::intptr_t size = lag(enqueue, dequeue);
+            if (size <= 0)
+            {
+                return 0;
+            }
+            return static_cast<size_type>(size) > Size ? Size : static_cast<size_type>(size);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        size_type max_size() const
+        {
+            return Size;
+        }
+
+        // Callable from any thread
+        BufferStatistics statistics() const
+        {
+            static_assert(Instrumented, "statistics require MPMCCircularBuffer<T, Size, true>");
+            return Counters::statistics();
+        }
+
+        void reset_statistics()
+        {
+            static_assert(Instrumented, "statistics require MPMCCircularBuffer<T, Size, true>");
+            Counters::reset_statistics();
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_MPMCCIRCULARBUFFER_HPP
@@ -0,0 +1,297 @@
+#ifndef CXXCIRCULARBUFFER_MIRROREDCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_MIRROREDCIRCULARBUFFER_HPP
+
+#if defined(__linux__)
+
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace CXXCircularBuffer
+{
+
+    // Ring whose storage is mapped twice, back to back, in virtual memory, so
+    // that the content and the free space are always contiguous: data() is
+    // valid for size() elements and free_data() for capacity() - size()
+    // elements, whatever the wrap position. Linux only (memfd_create + mmap).
+    //
+    // The capacity is rounded up so that the storage is a whole number of
+    // pages. Unlike CircularBuffer, writes never overwrite: write() stores only
+    // what fits in the free space.
+    template <typename T = unsigned char>
+    class MirroredCircularBuffer
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "MirroredCircularBuffer requires a trivially copyable type");
+
+    private:
+        T *data_ = nullptr;
+        std::size_t capacity_ = 0;
+        // Offset of the oldest element, always below capacity_
+        std::size_t tail_ = 0;
+        std::size_t size_ = 0;
+
+        // Bytes of one copy of the storage, small enough to be mapped twice
+        static std::size_t storage_bytes(std::size_t min_capacity)
+        {
+            const std::size_t limit = std::numeric_limits<std::size_t>::max() / 2;
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t granule = std::lcm(page, sizeof(T));
+            min_capacity = std::max<std::size_t>(min_capacity, 1);
+            if (min_capacity > limit / sizeof(T))
+            {
+                throw std::length_error("MirroredCircularBuffer capacity is too large");
+            }
+            const std::size_t bytes = min_capacity * sizeof(T);
+            // Rounding up to the granule must not pass the limit either
+            if (bytes > limit - (granule - 1))
+            {
+                throw std::length_error("MirroredCircularBuffer capacity is too large");
+            }
+            return (bytes + granule - 1) / granule * granule;
+        }
+
+        static void throw_errno(const char *what)
+        {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        std::size_t storage_size() const
+        {
+            return capacity_ * sizeof(T);
+        }
+
+        void release()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(data_, 2 * storage_size());
+                data_ = nullptr;
+            }
+        }
+
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        // Throws std::length_error if twice the storage does not fit in the
+        // address space, and std::system_error if the mirrored mapping cannot
+        // be created
+        explicit MirroredCircularBuffer(size_type min_capacity)
+        {
+            const std::size_t bytes = storage_bytes(min_capacity);
+
+            const int fd = ::memfd_create("CXXCircularBuffer", MFD_CLOEXEC);
+            if (fd == -1)
+            {
+                throw_errno("memfd_create");
+            }
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), "ftruncate");
+            }
+
+            // Reserve a range twice the storage size, then map the file over
+            // both halves
+            void *base = ::mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), "mmap");
+            }
+            char *first = static_cast<char *>(base);
+            if (::mmap(first, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+                ::mmap(first + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                const int error = errno;
+                ::munmap(base, 2 * bytes);
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), "mmap");
+            }
+            // The mappings keep the memory alive
+            ::close(fd);
+
+            data_ = reinterpret_cast<T *>(first);
+            capacity_ = bytes / sizeof(T);
+        }
+
+        MirroredCircularBuffer(MirroredCircularBuffer &&other) noexcept
+            : data_(std::exchange(other.data_, nullptr)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              tail_(std::exchange(other.tail_, 0)),
+              size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        MirroredCircularBuffer &operator=(MirroredCircularBuffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                data_ = std::exchange(other.data_, nullptr);
+                capacity_ = std::exchange(other.capacity_, 0);
+                tail_ = std::exchange(other.tail_, 0);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        MirroredCircularBuffer(const MirroredCircularBuffer &) = delete;
+        MirroredCircularBuffer &operator=(const MirroredCircularBuffer &) = delete;
+
+        ~MirroredCircularBuffer()
+        {
+            release();
+        }
+
+        size_type size() const
+        {
+            return size_;
+        }
+
+        size_type capacity() const
+        {
+            return capacity_;
+        }
+
+        size_type max_size() const
+        {
+            return capacity_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        bool full() const
+        {
+            return size_ == capacity_;
+        }
+
+        // Oldest element; the whole content is contiguous from here
+        pointer data()
+        {
+            return data_ + tail_;
+        }
+
+        const_pointer data() const
+        {
+            return data_ + tail_;
+        }
+
+        Span<T> array()
+        {
+            return Span<T>(data(), size_);
+        }
+
+        Span<const T> array() const
+        {
+            return Span<const T>(data(), size_);
+        }
+
+        // First free element; the whole free space is contiguous from here
+        pointer free_data()
+        {
+            return data_ + tail_ + size_;
+        }
+
+        Span<T> free_array()
+        {
+            return Span<T>(free_data(), capacity_ - size_);
+        }
+
+        reference operator[](size_type index)
+        {
+            return data_[tail_ + index];
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return data_[tail_ + index];
+        }
+
+        reference front()
+        {
+            return data_[tail_];
+        }
+
+        reference back()
+        {
+            return data_[tail_ + size_ - 1];
+        }
+
+        const_reference front() const
+        {
+            return data_[tail_];
+        }
+
+        const_reference back() const
+        {
+            return data_[tail_ + size_ - 1];
+        }
+
+        // Appends the first count elements written into the free space
+        void commit(size_type count)
+        {
+            size_ += std::min(count, capacity_ - size_);
+        }
+
+        // Copies as many elements as fit into the free space and returns how
+        // many were written
+        size_type write(Span<const T> items)
+        {
+            const std::size_t count = std::min(items.size(), capacity_ - size_);
+            if (count != 0)
+            {
+                std::memcpy(static_cast<void *>(free_data()), items.data(), count * sizeof(T));
+                size_ += count;
+            }
+            return count;
+        }
+
+        // Removes up to count of the oldest elements and returns how many were
+        // removed
+        size_type consume(size_type count)
+        {
+            count = std::min(count, size_);
+            tail_ += count;
+            if (tail_ >= capacity_)
+            {
+                tail_ -= capacity_;
+            }
+            size_ -= count;
+            return count;
+        }
+
+        void clear()
+        {
+            tail_ = 0;
+            size_ = 0;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // defined(__linux__)
+
+#endif // CXXCIRCULARBUFFER_MIRROREDCIRCULARBUFFER_HPP
@@ -0,0 +1,42 @@
+#ifndef CXXCIRCULARBUFFER_OVERFLOWPOLICY_HPP
+#define CXXCIRCULARBUFFER_OVERFLOWPOLICY_HPP
+
+namespace CXXCircularBuffer
+{
+
+    // What a push into a full buffer does. Chosen at compile time, so the
+    // push paths of a buffer only contain the code of their own policy.
+    enum class OverflowPolicy
+    {
+        // Replaces the oldest element: the buffer keeps the latest elements
+        OverwriteOldest,
+        // Refuses the new element and reports it, so the caller can apply
+        // backpressure or retry later
+        RejectNew,
+        // Discards the new element: the buffer keeps the earliest elements
+        DropNewest,
+        // Waits until a consumer makes room (concurrent buffers only)
+        Block
+    };
+
+    // Outcome of a push
+    enum class PushStatus
+    {
+        // Stored in a free slot
+        Pushed,
+        // Stored in place of the oldest element, which was lost
+        Overwritten,
+        // Not stored, the buffer was full (OverflowPolicy::RejectNew)
+        Rejected,
+        // Not stored, the buffer was full (OverflowPolicy::DropNewest)
+        Dropped
+    };
+
+    // True when the pushed element ended up in the buffer
+    constexpr bool stored(PushStatus status)
+    {
+        return status == PushStatus::Pushed || status == PushStatus::Overwritten;
+    }
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_OVERFLOWPOLICY_HPP
@@ -0,0 +1,443 @@
+#ifndef CXXCIRCULARBUFFER_PERSISTENTCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_PERSISTENTCIRCULARBUFFER_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <CXXCircularBuffer/CircularBufferIterator.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CXXCircularBuffer
+{
+
+    // Ring stored in a memory-mapped file, so that its content survives the
+    // process: opening the same file again recovers the elements in O(1),
+    // straight from the header, with no log to replay.
+    //
+    // The file starts with a header page holding the capacity, the offset of
+    // the element data and two 64-bit counters, head (elements ever pushed) and tail (elements ever removed);
+    // size is head - tail and the buffer is full when it equals the capacity.
+    // Every operation makes a single counter store its commit point, ordered
+    // after the element data it covers in the process's view of the mapping,
+    // which the page cache keeps across a process crash:
+    // - after a process crash the file holds every completed operation, and
+    //   the header only covers complete elements
+    // - after a system crash the file is only known to be consistent if no
+    //   operation followed the last sync(). The kernel may write the header
+    //   page back before the data pages at any time, so the header can cover
+    //   elements pushed since then whose data never reached the disk.
+    //
+    // Like CircularBuffer, a push into a full buffer overwrites the oldest
+    // element. Not safe for concurrent use, within or across processes.
+    template <typename T>
+    class PersistentCircularBuffer
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "PersistentCircularBuffer requires a trivially copyable type");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "PersistentCircularBuffer requires lock-free 64-bit atomics");
+
+    private:
+        // "CXXRING1" in little-endian byte order
+        static constexpr std::uint64_t Magic = 0x31474E4952585843ull;
+        static constexpr std::uint32_t Version = 2;
+
+        struct Header
+        {
+            // Written last when the file is created: a file without it is
+            // initialized again
+            std::atomic<std::uint64_t> magic;
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t capacity;
+            // The page size of the system that created the file, which may
+            // differ from the one reopening it
+            std::uint64_t data_offset;
+            std::atomic<std::uint64_t> head;
+            std::atomic<std::uint64_t> tail;
+        };
+
+        Header *header_ = nullptr;
+        T *data_ = nullptr;
+        std::size_t capacity_ = 0;
+        // Size of the header page, which keeps the element data page aligned.
+        // Recorded in the header as data_offset.
+        std::size_t header_size_ = 0;
+
+        static void throw_errno(const char *what)
+        {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        std::size_t file_size() const
+        {
+            return header_size_ + capacity_ * sizeof(T);
+        }
+
+        std::size_t slot_of(std::uint64_t counter) const
+        {
+            return static_cast<std::size_t>(counter % capacity_);
+        }
+
+        void release()
+        {
+            if (header_ != nullptr)
+            {
+                ::munmap(header_, file_size());
+                header_ = nullptr;
+                data_ = nullptr;
+            }
+        }
+
+        [[noreturn]] static void throw_mismatch()
+        {
+            throw std::runtime_error("file does not hold a ring of this element type and capacity");
+        }
+
+        // Checks the header of an existing ring before anything is mapped or
+        // resized, so that a foreign file is never modified, and adopts the data
+        // offset it records. Returns false for a file that still has to be
+        // initialized: an empty one, or one left by an interrupted creation of
+        // this very ring.
+        bool check_existing(int fd, std::size_t size)
+        {
+            unsigned char bytes[sizeof(Header)];
+            if (size == 0)
+            {
+                return false;
+            }
+            if (size < sizeof(Header))
+            {
+                throw_mismatch();
+            }
+            if (::pread(fd, bytes, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)))
+            {
+                throw_errno("pread");
+            }
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t capacity;
+            std::uint64_t data_offset;
+            std::memcpy(&magic, bytes + offsetof(Header, magic), sizeof(magic));
+            std::memcpy(&version, bytes + offsetof(Header, version), sizeof(version));
+            std::memcpy(&element_size, bytes + offsetof(Header, element_size), sizeof(element_size));
+            std::memcpy(&capacity, bytes + offsetof(Header, capacity), sizeof(capacity));
+            std::memcpy(&data_offset, bytes + offsetof(Header, data_offset), sizeof(data_offset));
+            if (magic == 0)
+            {
+                // A creation interrupted before it completed has already sized
+                // the file, and written either none of the header or exactly
+                // this ring's fields
+                const bool blank = version == 0 && element_size == 0 && capacity == 0 && data_offset == 0;
+                const bool ours = version == Version && element_size == sizeof(T) && capacity == capacity_ &&
+                                  data_offset == header_size_;
+                if (size != file_size() || !(blank || ours))
+                {
+                    throw_mismatch();
+                }
+                return false;
+            }
+            if (magic != Magic || version != Version || element_size != sizeof(T) || capacity != capacity_)
+            {
+                throw_mismatch();
+            }
+            // The data must follow the header, aligned for T, and end the file
+            if (data_offset < sizeof(Header) || data_offset % alignof(T) != 0 || data_offset > size ||
+                size - data_offset != capacity_ * sizeof(T))
+            {
+                throw_mismatch();
+            }
+            header_size_ = static_cast<std::size_t>(data_offset);
+            return true;
+        }
+
+        void map(int fd, std::size_t capacity)
+        {
+            header_size_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            if (capacity > (std::numeric_limits<std::size_t>::max() - header_size_) / sizeof(T))
+            {
+                throw std::length_error("PersistentCircularBuffer capacity too large");
+            }
+            capacity_ = capacity;
+
+            struct stat status;
+            if (::fstat(fd, &status) == -1)
+            {
+                throw_errno("fstat");
+            }
+            const bool existing = check_existing(fd, static_cast<std::size_t>(status.st_size));
+            if (!existing && ::ftruncate(fd, static_cast<off_t>(file_size())) == -1)
+            {
+                throw_errno("ftruncate");
+            }
+
+            void *base = ::mmap(nullptr, file_size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                throw_errno("mmap");
+            }
+            header_ = static_cast<Header *>(base);
+            data_ = reinterpret_cast<T *>(static_cast<char *>(base) + header_size_);
+
+            if (!existing)
+            {
+                header_->version = Version;
+                header_->element_size = static_cast<std::uint32_t>(sizeof(T));
+                header_->capacity = capacity_;
+                header_->data_offset = header_size_;
+                header_->head.store(0, std::memory_order_relaxed);
+                header_->tail.store(0, std::memory_order_relaxed);
+                header_->magic.store(Magic, std::memory_order_release);
+                sync();
+                return;
+            }
+
+            // Recovery: the counters are the whole state
+            const std::uint64_t head = header_->head.load(std::memory_order_acquire);
+            const std::uint64_t tail = header_->tail.load(std::memory_order_acquire);
+            if (head < tail || head - tail > capacity_)
+            {
+                throw_mismatch();
+            }
+        }
+
+    public:
+        typedef T value_type;
+        typedef const T *const_pointer;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef detail::RingIterator<PersistentCircularBuffer, false> const_iterator;
+        typedef detail::RingIterator<PersistentCircularBuffer, true> const_reverse_iterator;
+
+        // Opens the ring stored at path, creating the file if needed. Throws
+        // std::system_error if the file cannot be opened or mapped,
+        // std::runtime_error if it holds a ring of another type or capacity, and
+        // std::length_error if capacity elements do not fit in a file.
+        PersistentCircularBuffer(const std::string &path, size_type capacity)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("PersistentCircularBuffer capacity must be greater than zero");
+            }
+            const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd == -1)
+            {
+                throw_errno("open");
+            }
+            try
+            {
+                map(fd, capacity);
+            }
+            catch (...)
+            {
+                release();
+                ::close(fd);
+                throw;
+            }
+            // The mapping keeps the file open
+            ::close(fd);
+        }
+
+        PersistentCircularBuffer(PersistentCircularBuffer &&other) noexcept
+            : header_(std::exchange(other.header_, nullptr)),
+              data_(std::exchange(other.data_, nullptr)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              header_size_(std::exchange(other.header_size_, 0))
+        {
+        }
+
+        PersistentCircularBuffer &operator=(PersistentCircularBuffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                header_ = std::exchange(other.header_, nullptr);
+                data_ = std::exchange(other.data_, nullptr);
+                capacity_ = std::exchange(other.capacity_, 0);
+                header_size_ = std::exchange(other.header_size_, 0);
+            }
+            return *this;
+        }
+
+        PersistentCircularBuffer(const PersistentCircularBuffer &) = delete;
+        PersistentCircularBuffer &operator=(const PersistentCircularBuffer &) = delete;
+
+        // Unmaps the file without waiting for it to reach the disk; call sync()
+        // first to make the content durable
+        ~PersistentCircularBuffer()
+        {
+            release();
+        }
+
+        // Writes the element data, then the header, to the disk and waits for
+        // both. On return the disk holds a consistent ring, until the next
+        // operation; see the class comment. Throws std::system_error on
+        // failure.
+        void sync()
+        {
+            if (::msync(data_, capacity_ * sizeof(T), MS_SYNC) == -1 ||
+                ::msync(header_, header_size_, MS_SYNC) == -1)
+            {
+                throw_errno("msync");
+            }
+        }
+
+        size_type size() const
+        {
+            return static_cast<size_type>(header_->head.load(std::memory_order_relaxed) -
+                                          header_->tail.load(std::memory_order_relaxed));
+        }
+
+        size_type capacity() const
+        {
+            return capacity_;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        bool full() const
+        {
+            return size() == capacity_;
+        }
+
+        void push_back(const T &item)
+        {
+            const std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+            const std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+            if (head - tail == capacity_)
+            {
+                // Drops the oldest element before its slot is reused, so the
+                // header never covers a half-written element. A release fence
+                // would not keep the plain stores of the memcpy below from
+                // moving ahead of this store: the full fence does, for both
+                // the compiler and the CPU.
+                header_->tail.store(tail + 1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+            std::memcpy(static_cast<void *>(data_ + slot_of(head)), &item, sizeof(T));
+            header_->head.store(head + 1, std::memory_order_release);
+        }
+
+        void pop_front()
+        {
+            if (!empty())
+            {
+                header_->tail.store(header_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+        }
+
+        // Copies the oldest element into item and removes it. Returns false,
+        // leaving item untouched, when the buffer is empty.
+        bool pop_front(T &item)
+        {
+            if (empty())
+            {
+                return false;
+            }
+            item = front();
+            pop_front();
+            return true;
+        }
+
+        void clear()
+        {
+            header_->tail.store(header_->head.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        const_reference front() const
+        {
+            return data_[slot_of(header_->tail.load(std::memory_order_relaxed))];
+        }
+
+        const_reference back() const
+        {
+            return data_[slot_of(header_->head.load(std::memory_order_relaxed) - 1)];
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return data_[slot_of(header_->tail.load(std::memory_order_relaxed) + index)];
+        }
+
+        Span<const T> array_one() const
+        {
+            const std::size_t start = slot_of(header_->tail.load(std::memory_order_relaxed));
+            const std::size_t used = size();
+            return Span<const T>(data_ + start, used < capacity_ - start ? used : capacity_ - start);
+        }
+
+        Span<const T> array_two() const
+        {
+            const std::size_t start = slot_of(header_->tail.load(std::memory_order_relaxed));
+            const std::size_t used = size();
+            return Span<const T>(data_, used - (used < capacity_ - start ? used : capacity_ - start));
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, slot_of(header_->tail.load(std::memory_order_relaxed)), 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, slot_of(header_->head.load(std::memory_order_relaxed)), size());
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(this, slot_of(header_->head.load(std::memory_order_relaxed) - 1), 0);
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(this, slot_of(header_->tail.load(std::memory_order_relaxed) + capacity_ - 1),
+                                          size());
+        }
+
+    private:
+        template <typename, bool>
+        friend class detail::RingIterator;
+
+        const_reference slot(std::size_t index) const
+        {
+            return data_[index];
+        }
+
+        std::size_t step(std::size_t index, std::ptrdiff_t n) const
+        {
+            const std::ptrdiff_t moved = static_cast<std::ptrdiff_t>(index) + n;
+            if (moved < 0)
+            {
+                return static_cast<std::size_t>(moved + static_cast<std::ptrdiff_t>(capacity_));
+            }
+            return static_cast<std::size_t>(moved) >= capacity_ ? static_cast<std::size_t>(moved) - capacity_
+                                                                : static_cast<std::size_t>(moved);
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // CXXCIRCULARBUFFER_PERSISTENTCIRCULARBUFFER_HPP
@@ -0,0 +1,508 @@
+#ifndef CXXCIRCULARBUFFER_QUANTILEWINDOW_HPP
+#define CXXCIRCULARBUFFER_QUANTILEWINDOW_HPP
+
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace CXXCircularBuffer
+{
+
+    enum class QuantileMode
+    {
+        // Order-statistic tree over the window: exact answers, O(log Size)
+        // expected per push, eviction and query
+        Exact,
+        // Log-linear histogram of the window (unsigned integers only): answers
+        // within a relative error of 2^-Precision, O(log buckets) per push,
+        // eviction and query, memory independent of the value range
+        Approximate
+    };
+
+    // Last Size samples with order statistics (median, p99, ...) kept up to
+    // date. A push into a full window evicts the oldest sample, exactly as
+    // CircularBuffer::push_back does, and removes it from the order structure.
+    //
+    // Quantiles use the nearest-rank definition: quantile(q) is the
+    // ceil(q * size())-th smallest sample (the smallest one for q = 0).
+    template <typename T, size_t Size, QuantileMode Mode = QuantileMode::Exact, unsigned Precision = 7>
+    class QuantileWindow;
+
+    template <typename T, size_t Size, unsigned Precision>
+    class QuantileWindow<T, Size, QuantileMode::Exact, Precision>
+    {
+        static_assert(Size <= std::numeric_limits<std::uint32_t>::max() / 2, "QuantileWindow capacity is too large");
+
+    public:
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef typename CircularBuffer<T, Size>::const_iterator const_iterator;
+
+    private:
+        static constexpr std::int32_t Nil = -1;
+
+        // Treap node; node i holds the sample stored in ring slot i, so nodes
+        // are recycled in the same order as the ring overwrites samples
+        struct Node
+        {
+            T value;
+            std::uint32_t priority;
+            std::uint32_t count;
+            std::int32_t left;
+            std::int32_t right;
+        };
+
+        CircularBuffer<T, Size> window_;
+        detail::UninitializedArray<Node, Size> nodes_;
+        std::int32_t root_ = Nil;
+        // Node of the next sample, and of the oldest sample in the window
+        std::size_t next_node_ = 0;
+        std::size_t oldest_node_ = 0;
+        std::uint32_t seed_ = 0x9E3779B9u;
+
+        std::uint32_t random()
+        {
+            // xorshift32
+            seed_ ^= seed_ << 13;
+            seed_ ^= seed_ >> 17;
+            seed_ ^= seed_ << 5;
+            return seed_;
+        }
+
+        static std::size_t next(std::size_t node)
+        {
+            return node + 1 == Size ? 0 : node + 1;
+        }
+
+        std::uint32_t count(std::int32_t node) const
+        {
+            return node == Nil ? 0 : nodes_[node].count;
+        }
+
+        void update(std::int32_t node)
+        {
+            nodes_[node].count = 1 + count(nodes_[node].left) + count(nodes_[node].right);
+        }
+
+        // Orders by value, then by node to tell equal samples apart
+        bool less(std::int32_t a, std::int32_t b) const
+        {
+            if (nodes_[a].value < nodes_[b].value)
+            {
+                return true;
+            }
+            if (nodes_[b].value < nodes_[a].value)
+            {
+                return false;
+            }
+            return a < b;
+        }
+
+        std::int32_t merge(std::int32_t left, std::int32_t right)
+        {
+            if (left == Nil)
+            {
+                return right;
+            }
+            if (right == Nil)
+            {
+                return left;
+            }
+            if (nodes_[left].priority > nodes_[right].priority)
+            {
+                nodes_[left].right = merge(nodes_[left].right, right);
+                update(left);
+                return left;
+            }
+            nodes_[right].left = merge(left, nodes_[right].left);
+            update(right);
+            return right;
+        }
+
+        std::int32_t insert(std::int32_t root, std::int32_t node)
+        {
+            if (root == Nil)
+            {
+                return node;
+            }
+            if (nodes_[node].priority > nodes_[root].priority)
+            {
+                split(root, node, nodes_[node].left, nodes_[node].right);
+                update(node);
+                return node;
+            }
+            if (less(node, root))
+            {
+                nodes_[root].left = insert(nodes_[root].left, node);
+            }
+            else
+            {
+                nodes_[root].right = insert(nodes_[root].right, node);
+            }
+            update(root);
+            return root;
+        }
+
+        // Splits root into the nodes ordered before key and the others
+        void split(std::int32_t root, std::int32_t key, std::int32_t &left, std::int32_t &right)
+        {
+            if (root == Nil)
+            {
+                left = right = Nil;
+                return;
+            }
+            if (less(root, key))
+            {
+                split(nodes_[root].right, key, nodes_[root].right, right);
+                left = root;
+            }
+            else
+            {
+                split(nodes_[root].left, key, left, nodes_[root].left);
+                right = root;
+            }
+            update(root);
+        }
+
+        std::int32_t erase(std::int32_t root, std::int32_t node)
+        {
+            if (root == node)
+            {
+                return merge(nodes_[root].left, nodes_[root].right);
+            }
+            if (less(node, root))
+            {
+                nodes_[root].left = erase(nodes_[root].left, node);
+            }
+            else
+            {
+                nodes_[root].right = erase(nodes_[root].right, node);
+            }
+            update(root);
+            return root;
+        }
+
+        void evict_oldest()
+        {
+            const std::int32_t node = static_cast<std::int32_t>(oldest_node_);
+            root_ = erase(root_, node);
+            nodes_.destroy(oldest_node_);
+            oldest_node_ = next(oldest_node_);
+            window_.pop_front();
+        }
+
+    public:
+        QuantileWindow() = default;
+
+        QuantileWindow(const QuantileWindow &) = delete;
+        QuantileWindow &operator=(const QuantileWindow &) = delete;
+
+        ~QuantileWindow()
+        {
+            clear();
+        }
+
+        void push_back(const T &value)
+        {
+            if (window_.full())
+            {
+                evict_oldest();
+            }
+            nodes_.construct(next_node_, Node{value, random(), 1, Nil, Nil});
+            root_ = insert(root_, static_cast<std::int32_t>(next_node_));
+            next_node_ = next(next_node_);
+            window_.push_back(value);
+        }
+
+        void pop_front()
+        {
+            if (!window_.empty())
+            {
+                evict_oldest();
+            }
+        }
+
+        void clear()
+        {
+            while (!window_.empty())
+            {
+                nodes_.destroy(oldest_node_);
+                oldest_node_ = next(oldest_node_);
+                window_.pop_front();
+            }
+            root_ = Nil;
+            next_node_ = oldest_node_ = 0;
+        }
+
+        // rank-th smallest sample, 0-based; rank < size()
+        const_reference select(size_type rank) const
+        {
+            std::int32_t node = root_;
+            for (;;)
+            {
+                const std::uint32_t left = count(nodes_[node].left);
+                if (rank < left)
+                {
+                    node = nodes_[node].left;
+                }
+                else if (rank == left)
+                {
+                    return nodes_[node].value;
+                }
+                else
+                {
+                    rank -= left + 1;
+                    node = nodes_[node].right;
+                }
+            }
+        }
+
+        // Number of samples strictly smaller than value
+        size_type rank(const T &value) const
+        {
+            size_type result = 0;
+            std::int32_t node = root_;
+            while (node != Nil)
+            {
+                if (nodes_[node].value < value)
+                {
+                    result += count(nodes_[node].left) + 1;
+                    node = nodes_[node].right;
+                }
+                else
+                {
+                    node = nodes_[node].left;
+                }
+            }
+            return result;
+        }
+
+        // 0 <= q <= 1; the window must not be empty
+        const_reference quantile(double q) const
+        {
+            const double position = std::ceil(q * static_cast<double>(window_.size()));
+            const size_type rank = position < 1 ? 0 : static_cast<size_type>(position) - 1;
+            return select(rank < window_.size() ? rank : window_.size() - 1);
+        }
+
+        const_reference median() const
+        {
+            return quantile(0.5);
+        }
+
+        size_type size() const
+        {
+            return window_.size();
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        bool empty() const
+        {
+            return window_.empty();
+        }
+
+        bool full() const
+        {
+            return window_.full();
+        }
+
+        const CircularBuffer<T, Size> &window() const
+        {
+            return window_;
+        }
+
+        const_iterator begin() const
+        {
+            return window_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return window_.end();
+        }
+    };
+
+    template <typename T, size_t Size, unsigned Precision>
+    class QuantileWindow<T, Size, QuantileMode::Approximate, Precision>
+    {
+        static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                      "approximate quantiles require an unsigned integral type");
+        static_assert(Precision >= 1 && Precision < std::numeric_limits<T>::digits,
+                      "Precision must be smaller than the number of bits of T");
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef typename CircularBuffer<T, Size>::const_iterator const_iterator;
+
+    private:
+        static constexpr unsigned Bits = std::numeric_limits<T>::digits;
+        // Values below 2^Precision get a bucket each; every following power of
+        // two range is split into 2^(Precision - 1) buckets
+        static constexpr std::size_t LinearBuckets = std::size_t(1) << Precision;
+        static constexpr std::size_t SubBuckets = std::size_t(1) << (Precision - 1);
+        static constexpr std::size_t Buckets = LinearBuckets + (Bits - Precision) * SubBuckets;
+
+        CircularBuffer<T, Size> window_;
+        // Fenwick tree of bucket counts, 1-based
+        std::size_t tree_[Buckets + 1] = {};
+
+        static unsigned log2(T value)
+        {
+            unsigned result = 0;
+            while (value >>= 1)
+            {
+                ++result;
+            }
+            return result;
+        }
+
+        static std::size_t bucket_of(T value)
+        {
+            if (value < LinearBuckets)
+            {
+                return static_cast<std::size_t>(value);
+            }
+            const unsigned exponent = log2(value);
+            const unsigned shift = exponent - Precision + 1;
+            return LinearBuckets + (exponent - Precision) * SubBuckets +
+                   (static_cast<std::size_t>(value >> shift) - SubBuckets);
+        }
+
+        // Middle of the range of values mapped to bucket
+        static T bucket_value(std::size_t bucket)
+        {
+            if (bucket < LinearBuckets)
+            {
+                return static_cast<T>(bucket);
+            }
+            const std::size_t range = (bucket - LinearBuckets) / SubBuckets;
+            const std::size_t offset = (bucket - LinearBuckets) % SubBuckets;
+            const unsigned shift = static_cast<unsigned>(range) + 1;
+            const T lower = static_cast<T>(static_cast<T>(SubBuckets + offset) << shift);
+            const T width = static_cast<T>(T(1) << shift);
+            return static_cast<T>(lower + (width - 1) / 2);
+        }
+
+        void add(std::size_t bucket, std::ptrdiff_t delta)
+        {
+            for (std::size_t i = bucket + 1; i <= Buckets; i += i & (~i + 1))
+            {
+                tree_[i] += static_cast<std::size_t>(delta);
+            }
+        }
+
+        void evict_oldest()
+        {
+            add(bucket_of(window_.front()), -1);
+            window_.pop_front();
+        }
+
+    public:
+        void push_back(T value)
+        {
+            if (window_.full())
+            {
+                evict_oldest();
+            }
+            add(bucket_of(value), 1);
+            window_.push_back(value);
+        }
+
+        void pop_front()
+        {
+            if (!window_.empty())
+            {
+                evict_oldest();
+            }
+        }
+
+        void clear()
+        {
+            window_.clear();
+            std::fill(tree_, tree_ + Buckets + 1, std::size_t(0));
+        }
+
+        // Approximation of the rank-th smallest sample, 0-based; rank < size()
+        T select(size_type rank) const
+        {
+            // Descends the Fenwick tree to the first bucket whose cumulative
+            // count exceeds rank
+            std::size_t position = 0;
+            std::size_t step = 1;
+            while (step * 2 <= Buckets)
+            {
+                step *= 2;
+            }
+            for (; step != 0; step /= 2)
+            {
+                if (position + step <= Buckets && tree_[position + step] <= rank)
+                {
+                    position += step;
+                    rank -= tree_[position];
+                }
+            }
+            return bucket_value(position);
+        }
+
+        // 0 <= q <= 1; the window must not be empty
+        T quantile(double q) const
+        {
+            const double position = std::ceil(q * static_cast<double>(window_.size()));
+            const size_type rank = position < 1 ? 0 : static_cast<size_type>(position) - 1;
+            return select(rank < window_.size() ? rank : window_.size() - 1);
+        }
+
+        T median() const
+        {
+            return quantile(0.5);
+        }
+
+        size_type size() const
+        {
+            return window_.size();
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        bool empty() const
+        {
+            return window_.empty();
+        }
+
+        bool full() const
+        {
+            return window_.full();
+        }
+
+        const CircularBuffer<T, Size> &window() const
+        {
+            return window_;
+        }
+
+        const_iterator begin() const
+        {
+            return window_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return window_.end();
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_QUANTILEWINDOW_HPP
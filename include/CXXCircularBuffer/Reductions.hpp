@@ -0,0 +1,571 @@
+#ifndef CXXCIRCULARBUFFER_REDUCTIONS_HPP
+#define CXXCIRCULARBUFFER_REDUCTIONS_HPP
+
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define CXXCIRCULARBUFFER_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Whole-window reductions over any buffer exposing array_one()/array_two().
+// Each reduction runs over the (at most two) contiguous segments, so the inner
+// loops carry no wrap logic. float and double segments use SSE2 or, when the
+// CPU supports it at run time, AVX2/FMA kernels; other types use scalar loops.
+// Sums of integral elements are accumulated in 64 bits, so a window of small
+// integers cannot wrap around its element type.
+namespace CXXCircularBuffer
+{
+    namespace detail
+    {
+        // Type sums of T are accumulated in: int64_t or uint64_t for integral
+        // types, T itself otherwise
+        template <typename T, bool Integral = std::is_integral<T>::value>
+        struct SumType
+        {
+            typedef T type;
+        };
+
+        template <typename T>
+        struct SumType<T, true>
+        {
+            typedef typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type type;
+        };
+
+        template <typename T>
+        struct ScalarKernels
+        {
+            typedef typename std::conditional<std::is_floating_point<T>::value, T, double>::type real_type;
+            typedef typename SumType<T>::type sum_type;
+
+            static sum_type sum(const T *data, std::size_t n)
+            {
+                sum_type result = sum_type();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    result += static_cast<sum_type>(data[i]);
+                }
+                return result;
+            }
+
+            // n > 0
+            static T minimum(const T *data, std::size_t n)
+            {
+                return *std::min_element(data, data + n);
+            }
+
+            // n > 0
+            static T maximum(const T *data, std::size_t n)
+            {
+                return *std::max_element(data, data + n);
+            }
+
+            static sum_type dot(const T *a, const T *b, std::size_t n)
+            {
+                sum_type result = sum_type();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    result += static_cast<sum_type>(a[i]) * static_cast<sum_type>(b[i]);
+                }
+                return result;
+            }
+
+            static real_type squared_deviation(const T *data, std::size_t n, real_type mean)
+            {
+                real_type result = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const real_type deviation = static_cast<real_type>(data[i]) - mean;
+                    result += deviation * deviation;
+                }
+                return result;
+            }
+        };
+
+        template <typename T>
+        struct Kernels : ScalarKernels<T>
+        {
+        };
+
+#if defined(CXXCIRCULARBUFFER_X86_SIMD)
+        inline bool cpu_has_avx2()
+        {
+            static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            return supported;
+        }
+
+        inline float horizontal_sum(__m128 v)
+        {
+            __m128 shuffled = _mm_movehl_ps(v, v);
+            __m128 sums = _mm_add_ps(v, shuffled);
+            shuffled = _mm_shuffle_ps(sums, sums, 1);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+
+        inline double horizontal_sum(__m128d v)
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+        }
+
+        // SSE2 is part of the x86-64 baseline, so these need no dispatch
+
+        inline float sum_sse(const float *data, std::size_t n)
+        {
+            __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps(), a2 = _mm_setzero_ps(), a3 = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                a0 = _mm_add_ps(a0, _mm_loadu_ps(data + i));
+                a1 = _mm_add_ps(a1, _mm_loadu_ps(data + i + 4));
+                a2 = _mm_add_ps(a2, _mm_loadu_ps(data + i + 8));
+                a3 = _mm_add_ps(a3, _mm_loadu_ps(data + i + 12));
+            }
+            for (; i + 4 <= n; i += 4)
+            {
+                a0 = _mm_add_ps(a0, _mm_loadu_ps(data + i));
+            }
+            float result = horizontal_sum(_mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3)));
+            for (; i < n; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        inline float minimum_sse(const float *data, std::size_t n)
+        {
+            __m128 m = _mm_set1_ps(data[0]);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                m = _mm_min_ps(m, _mm_loadu_ps(data + i));
+            }
+            m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+            float result = _mm_cvtss_f32(m);
+            for (; i < n; ++i)
+            {
+                result = std::min(result, data[i]);
+            }
+            return result;
+        }
+
+        inline float maximum_sse(const float *data, std::size_t n)
+        {
+            __m128 m = _mm_set1_ps(data[0]);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                m = _mm_max_ps(m, _mm_loadu_ps(data + i));
+            }
+            m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+            float result = _mm_cvtss_f32(m);
+            for (; i < n; ++i)
+            {
+                result = std::max(result, data[i]);
+            }
+            return result;
+        }
+
+        inline float dot_sse(const float *a, const float *b, std::size_t n)
+        {
+            __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+            float result = horizontal_sum(_mm_add_ps(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        inline float squared_deviation_sse(const float *data, std::size_t n, float mean)
+        {
+            const __m128 m = _mm_set1_ps(mean);
+            __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                const __m128 d0 = _mm_sub_ps(_mm_loadu_ps(data + i), m);
+                const __m128 d1 = _mm_sub_ps(_mm_loadu_ps(data + i + 4), m);
+                a0 = _mm_add_ps(a0, _mm_mul_ps(d0, d0));
+                a1 = _mm_add_ps(a1, _mm_mul_ps(d1, d1));
+            }
+            float result = horizontal_sum(_mm_add_ps(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += (data[i] - mean) * (data[i] - mean);
+            }
+            return result;
+        }
+
+        inline double sum_sse(const double *data, std::size_t n)
+        {
+            __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd(), a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                a0 = _mm_add_pd(a0, _mm_loadu_pd(data + i));
+                a1 = _mm_add_pd(a1, _mm_loadu_pd(data + i + 2));
+                a2 = _mm_add_pd(a2, _mm_loadu_pd(data + i + 4));
+                a3 = _mm_add_pd(a3, _mm_loadu_pd(data + i + 6));
+            }
+            double result = horizontal_sum(_mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3)));
+            for (; i < n; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        inline double dot_sse(const double *a, const double *b, std::size_t n)
+        {
+            __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+                a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+            }
+            double result = horizontal_sum(_mm_add_pd(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        inline double squared_deviation_sse(const double *data, std::size_t n, double mean)
+        {
+            const __m128d m = _mm_set1_pd(mean);
+            __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                const __m128d d0 = _mm_sub_pd(_mm_loadu_pd(data + i), m);
+                const __m128d d1 = _mm_sub_pd(_mm_loadu_pd(data + i + 2), m);
+                a0 = _mm_add_pd(a0, _mm_mul_pd(d0, d0));
+                a1 = _mm_add_pd(a1, _mm_mul_pd(d1, d1));
+            }
+            double result = horizontal_sum(_mm_add_pd(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += (data[i] - mean) * (data[i] - mean);
+            }
+            return result;
+        }
+
+        // AVX2/FMA kernels, only called after cpu_has_avx2()
+
+        __attribute__((target("avx2,fma"))) inline float horizontal_sum_avx(__m256 v)
+        {
+            return horizontal_sum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        __attribute__((target("avx2,fma"))) inline double horizontal_sum_avx(__m256d v)
+        {
+            return horizontal_sum(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+        }
+
+        __attribute__((target("avx2,fma"))) inline float sum_avx2(const float *data, std::size_t n)
+        {
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps(), a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                a0 = _mm256_add_ps(a0, _mm256_loadu_ps(data + i));
+                a1 = _mm256_add_ps(a1, _mm256_loadu_ps(data + i + 8));
+                a2 = _mm256_add_ps(a2, _mm256_loadu_ps(data + i + 16));
+                a3 = _mm256_add_ps(a3, _mm256_loadu_ps(data + i + 24));
+            }
+            for (; i + 8 <= n; i += 8)
+            {
+                a0 = _mm256_add_ps(a0, _mm256_loadu_ps(data + i));
+            }
+            float result = horizontal_sum_avx(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+            for (; i < n; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline float minimum_avx2(const float *data, std::size_t n)
+        {
+            __m256 m0 = _mm256_set1_ps(data[0]), m1 = m0;
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                m0 = _mm256_min_ps(m0, _mm256_loadu_ps(data + i));
+                m1 = _mm256_min_ps(m1, _mm256_loadu_ps(data + i + 8));
+            }
+            m0 = _mm256_min_ps(m0, m1);
+            __m128 m = _mm_min_ps(_mm256_castps256_ps128(m0), _mm256_extractf128_ps(m0, 1));
+            m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_min_ss(m, _mm_shuffle_ps(m, m, 1));
+            float result = _mm_cvtss_f32(m);
+            for (; i < n; ++i)
+            {
+                result = std::min(result, data[i]);
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline float maximum_avx2(const float *data, std::size_t n)
+        {
+            __m256 m0 = _mm256_set1_ps(data[0]), m1 = m0;
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                m0 = _mm256_max_ps(m0, _mm256_loadu_ps(data + i));
+                m1 = _mm256_max_ps(m1, _mm256_loadu_ps(data + i + 8));
+            }
+            m0 = _mm256_max_ps(m0, m1);
+            __m128 m = _mm_max_ps(_mm256_castps256_ps128(m0), _mm256_extractf128_ps(m0, 1));
+            m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+            m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+            float result = _mm_cvtss_f32(m);
+            for (; i < n; ++i)
+            {
+                result = std::max(result, data[i]);
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline float dot_avx2(const float *a, const float *b, std::size_t n)
+        {
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                a0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), a0);
+                a1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), a1);
+            }
+            float result = horizontal_sum_avx(_mm256_add_ps(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline float squared_deviation_avx2(const float *data, std::size_t n, float mean)
+        {
+            const __m256 m = _mm256_set1_ps(mean);
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(data + i), m);
+                const __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(data + i + 8), m);
+                a0 = _mm256_fmadd_ps(d0, d0, a0);
+                a1 = _mm256_fmadd_ps(d1, d1, a1);
+            }
+            float result = horizontal_sum_avx(_mm256_add_ps(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += (data[i] - mean) * (data[i] - mean);
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline double sum_avx2(const double *data, std::size_t n)
+        {
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd(), a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + i));
+                a1 = _mm256_add_pd(a1, _mm256_loadu_pd(data + i + 4));
+                a2 = _mm256_add_pd(a2, _mm256_loadu_pd(data + i + 8));
+                a3 = _mm256_add_pd(a3, _mm256_loadu_pd(data + i + 12));
+            }
+            for (; i + 4 <= n; i += 4)
+            {
+                a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + i));
+            }
+            double result = horizontal_sum_avx(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+            for (; i < n; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline double dot_avx2(const double *a, const double *b, std::size_t n)
+        {
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                a0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), a0);
+                a1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), a1);
+            }
+            double result = horizontal_sum_avx(_mm256_add_pd(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2,fma"))) inline double squared_deviation_avx2(const double *data, std::size_t n, double mean)
+        {
+            const __m256d m = _mm256_set1_pd(mean);
+            __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                const __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(data + i), m);
+                const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), m);
+                a0 = _mm256_fmadd_pd(d0, d0, a0);
+                a1 = _mm256_fmadd_pd(d1, d1, a1);
+            }
+            double result = horizontal_sum_avx(_mm256_add_pd(a0, a1));
+            for (; i < n; ++i)
+            {
+                result += (data[i] - mean) * (data[i] - mean);
+            }
+            return result;
+        }
+
+        template <>
+        struct Kernels<float> : ScalarKernels<float>
+        {
+            static float sum(const float *data, std::size_t n)
+            {
+                return cpu_has_avx2() ? sum_avx2(data, n) : sum_sse(data, n);
+            }
+
+            static float minimum(const float *data, std::size_t n)
+            {
+                return cpu_has_avx2() ? minimum_avx2(data, n) : minimum_sse(data, n);
+            }
+
+            static float maximum(const float *data, std::size_t n)
+            {
+                return cpu_has_avx2() ? maximum_avx2(data, n) : maximum_sse(data, n);
+            }
+
+            static float dot(const float *a, const float *b, std::size_t n)
+            {
+                return cpu_has_avx2() ? dot_avx2(a, b, n) : dot_sse(a, b, n);
+            }
+
+            static float squared_deviation(const float *data, std::size_t n, float mean)
+            {
+                return cpu_has_avx2() ? squared_deviation_avx2(data, n, mean) : squared_deviation_sse(data, n, mean);
+            }
+        };
+
+        // min/max of doubles are left to the scalar loop, which compilers
+        // already vectorize
+        template <>
+        struct Kernels<double> : ScalarKernels<double>
+        {
+            static double sum(const double *data, std::size_t n)
+            {
+                return cpu_has_avx2() ? sum_avx2(data, n) : sum_sse(data, n);
+            }
+
+            static double dot(const double *a, const double *b, std::size_t n)
+            {
+                return cpu_has_avx2() ? dot_avx2(a, b, n) : dot_sse(a, b, n);
+            }
+
+            static double squared_deviation(const double *data, std::size_t n, double mean)
+            {
+                return cpu_has_avx2() ? squared_deviation_avx2(data, n, mean) : squared_deviation_sse(data, n, mean);
+            }
+        };
+#endif // CXXCIRCULARBUFFER_X86_SIMD
+
+        template <typename Buffer>
+        using element_t = typename std::remove_cv<typename Buffer::value_type>::type;
+
+        template <typename Buffer>
+        using real_t = typename ScalarKernels<element_t<Buffer>>::real_type;
+
+        template <typename Buffer>
+        using sum_t = typename ScalarKernels<element_t<Buffer>>::sum_type;
+    } // namespace detail
+
+    // Sum of the window; int64_t or uint64_t for integral element types
+    template <typename Buffer>
+    detail::sum_t<Buffer> sum(const Buffer &buffer)
+    {
+        typedef detail::Kernels<detail::element_t<Buffer>> Kernels;
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return Kernels::sum(one.data(), one.size()) + Kernels::sum(two.data(), two.size());
+    }
+
+    // The buffer must not be empty
+    template <typename Buffer>
+    detail::element_t<Buffer> minimum(const Buffer &buffer)
+    {
+        typedef detail::Kernels<detail::element_t<Buffer>> Kernels;
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        const auto result = Kernels::minimum(one.data(), one.size());
+        return two.empty() ? result : std::min(result, Kernels::minimum(two.data(), two.size()));
+    }
+
+    // The buffer must not be empty
+    template <typename Buffer>
+    detail::element_t<Buffer> maximum(const Buffer &buffer)
+    {
+        typedef detail::Kernels<detail::element_t<Buffer>> Kernels;
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        const auto result = Kernels::maximum(one.data(), one.size());
+        return two.empty() ? result : std::max(result, Kernels::maximum(two.data(), two.size()));
+    }
+
+    // Arithmetic mean; double for integral element types. The buffer must not
+    // be empty.
+    template <typename Buffer>
+    detail::real_t<Buffer> mean(const Buffer &buffer)
+    {
+        return static_cast<detail::real_t<Buffer>>(sum(buffer)) / static_cast<detail::real_t<Buffer>>(buffer.size());
+    }
+
+    // Population variance, computed in two passes (mean, then squared
+    // deviations) for accuracy. The buffer must not be empty.
+    template <typename Buffer>
+    detail::real_t<Buffer> variance(const Buffer &buffer)
+    {
+        typedef detail::Kernels<detail::element_t<Buffer>> Kernels;
+        const detail::real_t<Buffer> average = mean(buffer);
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        const detail::real_t<Buffer> total = Kernels::squared_deviation(one.data(), one.size(), average) +
+                                             Kernels::squared_deviation(two.data(), two.size(), average);
+        return total / static_cast<detail::real_t<Buffer>>(buffer.size());
+    }
+
+    // Dot product of the window, oldest element first, with kernel, which must
+    // hold at least buffer.size() coefficients
+    template <typename Buffer>
+    detail::sum_t<Buffer> dot(const Buffer &buffer, Span<const detail::element_t<Buffer>> kernel)
+    {
+        typedef detail::Kernels<detail::element_t<Buffer>> Kernels;
+        const auto one = buffer.array_one();
+        const auto two = buffer.array_two();
+        return Kernels::dot(one.data(), kernel.data(), one.size()) +
+               Kernels::dot(two.data(), kernel.data() + one.size(), two.size());
+    }
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_REDUCTIONS_HPP
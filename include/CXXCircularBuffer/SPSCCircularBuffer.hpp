@@ -0,0 +1,272 @@
+#ifndef CXXCIRCULARBUFFER_SPSCCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_SPSCCIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+#include <CXXCircularBuffer/Statistics.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+
+    // Lock-free ring for exactly one producer thread and one consumer thread.
+    // try_push may only be called from the producer, try_pop from the consumer.
+    // Unlike CircularBuffer it never overwrites: a push into a full buffer fails.
+    // Instrumented enables the counters returned by statistics().
+    template <typename T, size_t Size, bool Instrumented = false>
+    class SPSCCircularBuffer : private detail::StatisticsCounters<Instrumented, true>
+    {
+        static_assert(Size > 0, "SPSCCircularBuffer capacity must be greater than zero");
+
+    private:
+        typedef detail::StatisticsCounters<Instrumented, true> Counters;
+
+        // One slot is always left empty so that head_ == tail_ means empty
+        static constexpr std::size_t Slots = Size + 1;
+
+        // Producer side: head_ is published to the consumer, cached_tail_ is the
+        // producer's last observed value of tail_
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+        alignas(detail::CACHE_LINE_SIZE) std::size_t cached_tail_ = 0;
+
+        // Consumer side: tail_ is published to the producer, cached_head_ is the
+        // consumer's last observed value of head_
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+        alignas(detail::CACHE_LINE_SIZE) std::size_t cached_head_ = 0;
+
+        alignas(detail::CACHE_LINE_SIZE) detail::UninitializedArray<T, Slots> slots_;
+
+        static std::size_t next_index(std::size_t index)
+        {
+            return (index + 1 == Slots) ? 0 : index + 1;
+        }
+
+        static std::size_t advance(std::size_t index, std::size_t count)
+        {
+            return (index + count >= Slots) ? index + count - Slots : index + count;
+        }
+
+        static std::size_t distance(std::size_t from, std::size_t to)
+        {
+            return (to >= from) ? (to - from) : (Slots - from + to);
+        }
+
+        // Producer side bookkeeping of statistics; reads the consumer index only
+        // when they are enabled
+        void pushed(std::size_t count, std::size_t head)
+        {
+            if constexpr (Instrumented)
+            {
+                this->record_push(count, distance(tail_.load(std::memory_order_relaxed), head));
+                this->record_not_full();
+            }
+        }
+
+        void rejected()
+        {
+            this->record_rejection(1);
+            this->record_full();
+        }
+
+        // count slots from index, split where the storage wraps
+        Segments<T> segments(std::size_t index, std::size_t count)
+        {
+            const std::size_t first_segment = (count < Slots - index) ? count : Slots - index;
+            return Segments<T>{Span<T>(slots_.data() + index, first_segment),
+                               Span<T>(slots_.data(), count - first_segment)};
+        }
+
+    public:
+        typedef T value_type;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+
+        SPSCCircularBuffer() = default;
+
+        ~SPSCCircularBuffer()
+        {
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            while (tail != head)
+            {
+                slots_.destroy(tail);
+                tail = next_index(tail);
+            }
+        }
+
+        SPSCCircularBuffer(const SPSCCircularBuffer &) = delete;
+        SPSCCircularBuffer &operator=(const SPSCCircularBuffer &) = delete;
+
+        // Producer only
+        template <typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t next = next_index(head);
+            if (next == cached_tail_)
+            {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (next == cached_tail_)
+                {
+                    rejected();
+                    return false;
+                }
+            }
+            slots_.construct(head, std::forward<Args>(args)...);
+            head_.store(next, std::memory_order_release);
+            pushed(1, next);
+            return true;
+        }
+
+        bool try_push(const T &item)
+        {
+            return try_emplace(item);
+        }
+
+        bool try_push(T &&item)
+        {
+            return try_emplace(std::move(item));
+        }
+
+        // Consumer only
+        bool try_pop(T &item)
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail == cached_head_)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail == cached_head_)
+                {
+                    return false;
+                }
+            }
+            item = std::move(slots_[tail]);
+            slots_.destroy(tail);
+            tail_.store(next_index(tail), std::memory_order_release);
+            this->record_pop(1);
+            return true;
+        }
+
+        // Consumer only. Returns the oldest element without removing it, or
+        // nullptr when the buffer is empty.
+        T *front()
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail == cached_head_)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail == cached_head_)
+                {
+                    return nullptr;
+                }
+            }
+            return &slots_[tail];
+        }
+
+        // Consumer only. Removes the element returned by front().
+        void pop_front()
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            slots_.destroy(tail);
+            tail_.store(next_index(tail), std::memory_order_release);
+            this->record_pop(1);
+        }
+
+        // Producer only. Two-phase write: returns up to count free slots, fewer
+        // when the buffer is nearly full, to be filled in place and published
+        // with commit(). Nothing is visible to the consumer before commit().
+        Segments<T> reserve(size_type count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "free space can only be written for trivially copyable types");
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            std::size_t available = Size - distance(cached_tail_, head);
+            if (available < count)
+            {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                available = Size - distance(cached_tail_, head);
+            }
+            return segments(head, (count < available) ? count : available);
+        }
+
+        // Producer only. Publishes the first count slots returned by reserve().
+        void commit(size_type count)
+        {
+            const std::size_t head = advance(head_.load(std::memory_order_relaxed), count);
+            head_.store(head, std::memory_order_release);
+            pushed(count, head);
+        }
+
+        // Consumer only. Two-phase read: up to count of the oldest elements, in
+        // place. They stay in the buffer until released with consume().
+        Segments<T> peek(size_type count)
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            std::size_t available = distance(tail, cached_head_);
+            if (available < count)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                available = distance(tail, cached_head_);
+            }
+            return segments(tail, (count < available) ? count : available);
+        }
+
+        // Consumer only. Removes the first count elements returned by peek().
+        void consume(size_type count)
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    slots_.destroy(advance(tail, i));
+                }
+            }
+            tail_.store(advance(tail, count), std::memory_order_release);
+            this->record_pop(count);
+        }
+
+        // Exact only when called while neither side is running; otherwise a snapshot
+        size_type size() const
+        {
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            return (head >= tail) ? (head - tail) : (Slots - tail + head);
+        }
+
+        bool empty() const
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        // Callable from any thread
+        BufferStatistics statistics() const
+        {
+            static_assert(Instrumented, "statistics require SPSCCircularBuffer<T, Size, true>");
+            return Counters::statistics();
+        }
+
+        void reset_statistics()
+        {
+            static_assert(Instrumented, "statistics require SPSCCircularBuffer<T, Size, true>");
+            Counters::reset_statistics();
+        }
+
+        size_type max_size() const
+        {
+            return Size;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_SPSCCIRCULARBUFFER_HPP
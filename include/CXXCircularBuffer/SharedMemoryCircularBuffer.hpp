@@ -0,0 +1,383 @@
+#ifndef CXXCIRCULARBUFFER_SHAREDMEMORYCIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_SHAREDMEMORYCIRCULARBUFFER_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CXXCircularBuffer
+{
+
+    // Lock-free single producer, single consumer ring in POSIX shared memory,
+    // for handing elements from one process to another without syscalls or
+    // intermediate copies. One process create()s the ring under a name (such
+    // as "/feed"), the other attach()es to it; one side may only push and the
+    // other only pop, as with SPSCCircularBuffer.
+    //
+    // The shared region holds no pointers, only counters and the offset of
+    // the elements, so each process can map it at a different address. Each
+    // side caches the other's counter in its own process memory. Older glibc
+    // versions need -lrt for shm_open.
+    template <typename T>
+    class SharedMemoryCircularBuffer
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "SharedMemoryCircularBuffer requires a trivially copyable type");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "SharedMemoryCircularBuffer requires address-free 64-bit atomics");
+
+    private:
+        // "CXXSHMQ1" in little-endian byte order
+        static constexpr std::uint64_t Magic = 0x31514D4853585843ull;
+        static constexpr std::uint32_t Version = 1;
+
+        // Layout of the start of the shared region
+        struct Header
+        {
+            // Stored last by create(): attach() refuses a region without it
+            std::atomic<std::uint64_t> magic;
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t capacity;
+            // Offset of the first element from the start of the region
+            std::uint64_t data_offset;
+            // Elements ever pushed, written by the producer
+            alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> head;
+            // Elements ever popped, written by the consumer
+            alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail;
+        };
+
+        static constexpr std::size_t DataOffset =
+            (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+        Header *header_ = nullptr;
+        T *data_ = nullptr;
+        std::size_t capacity_ = 0;
+        std::size_t mapped_size_ = 0;
+        // Set in the creating process, which removes the name when done
+        std::string name_;
+        // Producer's last observed tail, and consumer's last observed head
+        std::uint64_t cached_tail_ = 0;
+        std::uint64_t cached_head_ = 0;
+
+        SharedMemoryCircularBuffer() = default;
+
+        static void throw_errno(const char *what)
+        {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        std::size_t slot_of(std::uint64_t counter) const
+        {
+            return static_cast<std::size_t>(counter % capacity_);
+        }
+
+        // Elements between tail and head. The counters live in memory the
+        // other process can write, so a distance beyond the capacity, which
+        // only a corrupt header can produce, is reported as capacity_ + 1
+        // and never used as a copy size.
+        std::size_t distance(std::uint64_t head, std::uint64_t tail) const
+        {
+            const std::uint64_t used = head - tail;
+            return used > capacity_ ? capacity_ + 1 : static_cast<std::size_t>(used);
+        }
+
+        // Free slots for the producer; none if the counters are corrupt
+        std::size_t free_slots(std::uint64_t head, std::uint64_t tail) const
+        {
+            const std::size_t used = distance(head, tail);
+            return used > capacity_ ? 0 : capacity_ - used;
+        }
+
+        // Readable elements for the consumer; none if the counters are corrupt
+        std::size_t used_slots(std::uint64_t head, std::uint64_t tail) const
+        {
+            const std::size_t used = distance(head, tail);
+            return used > capacity_ ? 0 : used;
+        }
+
+        void map(int fd, std::size_t size)
+        {
+            void *base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                throw_errno("mmap");
+            }
+            header_ = static_cast<Header *>(base);
+            mapped_size_ = size;
+        }
+
+        void release()
+        {
+            if (header_ != nullptr)
+            {
+                ::munmap(header_, mapped_size_);
+                header_ = nullptr;
+                data_ = nullptr;
+            }
+            if (!name_.empty())
+            {
+                ::shm_unlink(name_.c_str());
+                name_.clear();
+            }
+        }
+
+        // Copies count elements starting at counter between the ring and items,
+        // in at most two segments
+        void copy_in(std::uint64_t counter, const T *items, std::size_t count)
+        {
+            const std::size_t start = slot_of(counter);
+            const std::size_t first_segment = count < capacity_ - start ? count : capacity_ - start;
+            std::memcpy(static_cast<void *>(data_ + start), items, first_segment * sizeof(T));
+            std::memcpy(static_cast<void *>(data_), items + first_segment, (count - first_segment) * sizeof(T));
+        }
+
+        void copy_out(std::uint64_t counter, T *items, std::size_t count) const
+        {
+            const std::size_t start = slot_of(counter);
+            const std::size_t first_segment = count < capacity_ - start ? count : capacity_ - start;
+            std::memcpy(static_cast<void *>(items), data_ + start, first_segment * sizeof(T));
+            std::memcpy(static_cast<void *>(items + first_segment), data_, (count - first_segment) * sizeof(T));
+        }
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+        // Creates the shared ring under name, which must not exist yet. The
+        // name is removed when the returned object is destroyed; processes
+        // still attached keep their mapping. Throws std::system_error.
+        static SharedMemoryCircularBuffer create(const std::string &name, size_type capacity)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("SharedMemoryCircularBuffer capacity must be greater than zero");
+            }
+            // The region size must fit both size_t and off_t
+            const std::size_t max_size =
+                static_cast<std::uintmax_t>(std::numeric_limits<off_t>::max()) < std::numeric_limits<std::size_t>::max()
+                    ? static_cast<std::size_t>(std::numeric_limits<off_t>::max())
+                    : std::numeric_limits<std::size_t>::max();
+            if (capacity > (max_size - DataOffset) / sizeof(T))
+            {
+                throw std::length_error("SharedMemoryCircularBuffer capacity is too large");
+            }
+            const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd == -1)
+            {
+                throw_errno("shm_open");
+            }
+            SharedMemoryCircularBuffer buffer;
+            buffer.name_ = name;
+            const std::size_t size = DataOffset + capacity * sizeof(T);
+            if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), "ftruncate");
+            }
+            try
+            {
+                buffer.map(fd, size);
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+
+            // The region starts zeroed, so both counters are already 0
+            Header *header = buffer.header_;
+            header->version = Version;
+            header->element_size = static_cast<std::uint32_t>(sizeof(T));
+            header->capacity = capacity;
+            header->data_offset = DataOffset;
+            header->magic.store(Magic, std::memory_order_release);
+
+            buffer.data_ = reinterpret_cast<T *>(reinterpret_cast<char *>(header) + DataOffset);
+            buffer.capacity_ = capacity;
+            return buffer;
+        }
+
+        // Attaches to a ring created by another process. Throws
+        // std::system_error if name cannot be opened or mapped, and
+        // std::runtime_error if it is not a fully created ring of T.
+        static SharedMemoryCircularBuffer attach(const std::string &name)
+        {
+            const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            if (fd == -1)
+            {
+                throw_errno("shm_open");
+            }
+            SharedMemoryCircularBuffer buffer;
+            struct stat status;
+            if (::fstat(fd, &status) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::system_category(), "fstat");
+            }
+            const std::size_t size = static_cast<std::size_t>(status.st_size);
+            if (size < sizeof(Header))
+            {
+                ::close(fd);
+                throw std::runtime_error("shared memory object is not a ring");
+            }
+            try
+            {
+                buffer.map(fd, size);
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+
+            const Header *header = buffer.header_;
+            if (header->magic.load(std::memory_order_acquire) != Magic || header->version != Version ||
+                header->element_size != sizeof(T) || header->capacity == 0 || header->data_offset % alignof(T) != 0 ||
+                header->data_offset > size || header->capacity > (size - header->data_offset) / sizeof(T))
+            {
+                throw std::runtime_error("shared memory object is not a ring of this element type");
+            }
+            buffer.data_ = reinterpret_cast<T *>(reinterpret_cast<char *>(buffer.header_) + header->data_offset);
+            buffer.capacity_ = static_cast<std::size_t>(header->capacity);
+            buffer.cached_tail_ = header->tail.load(std::memory_order_acquire);
+            buffer.cached_head_ = header->head.load(std::memory_order_acquire);
+            return buffer;
+        }
+
+        SharedMemoryCircularBuffer(SharedMemoryCircularBuffer &&other) noexcept
+            : header_(std::exchange(other.header_, nullptr)),
+              data_(std::exchange(other.data_, nullptr)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              mapped_size_(std::exchange(other.mapped_size_, 0)),
+              name_(std::move(other.name_)),
+              cached_tail_(other.cached_tail_),
+              cached_head_(other.cached_head_)
+        {
+            other.name_.clear();
+        }
+
+        SharedMemoryCircularBuffer &operator=(SharedMemoryCircularBuffer &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                header_ = std::exchange(other.header_, nullptr);
+                data_ = std::exchange(other.data_, nullptr);
+                capacity_ = std::exchange(other.capacity_, 0);
+                mapped_size_ = std::exchange(other.mapped_size_, 0);
+                name_ = std::move(other.name_);
+                other.name_.clear();
+                cached_tail_ = other.cached_tail_;
+                cached_head_ = other.cached_head_;
+            }
+            return *this;
+        }
+
+        SharedMemoryCircularBuffer(const SharedMemoryCircularBuffer &) = delete;
+        SharedMemoryCircularBuffer &operator=(const SharedMemoryCircularBuffer &) = delete;
+
+        ~SharedMemoryCircularBuffer()
+        {
+            release();
+        }
+
+        // Producer only. Copies as many elements of items as fit and returns
+        // their number; they become visible to the consumer all at once.
+        size_type write(Span<const T> items)
+        {
+            const std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+            std::size_t available = free_slots(head, cached_tail_);
+            if (available < items.size())
+            {
+                cached_tail_ = header_->tail.load(std::memory_order_acquire);
+                available = free_slots(head, cached_tail_);
+            }
+            const std::size_t count = items.size() < available ? items.size() : available;
+            if (count == 0)
+            {
+                return 0;
+            }
+            copy_in(head, items.data(), count);
+            header_->head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Producer only
+        bool try_push(const T &item)
+        {
+            return write(Span<const T>(&item, 1)) == 1;
+        }
+
+        // Consumer only. Moves up to items.size() of the oldest elements into
+        // items and returns their number.
+        size_type read(Span<T> items)
+        {
+            const std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+            std::size_t available = used_slots(cached_head_, tail);
+            if (available < items.size())
+            {
+                cached_head_ = header_->head.load(std::memory_order_acquire);
+                available = used_slots(cached_head_, tail);
+            }
+            const std::size_t count = items.size() < available ? items.size() : available;
+            if (count == 0)
+            {
+                return 0;
+            }
+            copy_out(tail, items.data(), count);
+            header_->tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Consumer only
+        bool try_pop(T &item)
+        {
+            return read(Span<T>(&item, 1)) == 1;
+        }
+
+        // A snapshot while the other process is running; 0 if the counters
+        // are corrupt
+        size_type size() const
+        {
+            const std::uint64_t tail = header_->tail.load(std::memory_order_acquire);
+            return used_slots(header_->head.load(std::memory_order_acquire), tail);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        size_type capacity() const
+        {
+            return capacity_;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // CXXCIRCULARBUFFER_SHAREDMEMORYCIRCULARBUFFER_HPP
@@ -0,0 +1,229 @@
+#ifndef CXXCIRCULARBUFFER_SLIDINGWINDOW_HPP
+#define CXXCIRCULARBUFFER_SLIDINGWINDOW_HPP
+
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace CXXCircularBuffer
+{
+
+    // CircularBuffer of the last Size samples that keeps its aggregates up to
+    // date as samples enter and leave the window, so every query is O(1):
+    // - sum, mean and variance with Welford's update, reversed on eviction
+    // - minimum and maximum with monotonic queues of the candidate extremes
+    // A push into a full window evicts the oldest sample, as push_back does.
+    template <typename T, size_t Size>
+    class SlidingWindow
+    {
+        static_assert(std::is_arithmetic<T>::value, "SlidingWindow requires an arithmetic type");
+
+    public:
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef typename std::common_type<T, double>::type real_type;
+        typedef typename CircularBuffer<T, Size>::const_iterator const_iterator;
+        typedef typename CircularBuffer<T, Size>::const_reverse_iterator const_reverse_iterator;
+
+    private:
+        // A sample and its position in the stream, used to recognise it when it
+        // leaves the window
+        struct Candidate
+        {
+            std::uint64_t sequence;
+            T value;
+        };
+
+        CircularBuffer<T, Size> window_;
+        // Values increase from front to back; the front is the minimum
+        CircularBuffer<Candidate, Size> minima_;
+        // Values decrease from front to back; the front is the maximum
+        CircularBuffer<Candidate, Size> maxima_;
+        // Sequence number of the oldest sample in the window
+        std::uint64_t oldest_ = 0;
+        real_type sum_ = 0;
+        real_type mean_ = 0;
+        // Sum of squared deviations from the mean
+        real_type m2_ = 0;
+
+        void evict_oldest()
+        {
+            const T value = window_.front();
+            window_.pop_front();
+
+            if (minima_.front().sequence == oldest_)
+            {
+                minima_.pop_front();
+            }
+            if (maxima_.front().sequence == oldest_)
+            {
+                maxima_.pop_front();
+            }
+            ++oldest_;
+
+            const std::size_t count = window_.size();
+            if (count == 0)
+            {
+                sum_ = mean_ = m2_ = 0;
+                return;
+            }
+            const real_type x = static_cast<real_type>(value);
+            sum_ -= x;
+            const real_type delta = x - mean_;
+            mean_ -= delta / static_cast<real_type>(count);
+            m2_ -= delta * (x - mean_);
+            if (m2_ < 0)
+            {
+                // Rounding can push an almost constant window below zero
+                m2_ = 0;
+            }
+        }
+
+    public:
+        SlidingWindow() = default;
+
+        void push_back(T value)
+        {
+            if (window_.full())
+            {
+                evict_oldest();
+            }
+            const std::uint64_t sequence = oldest_ + window_.size();
+            window_.push_back(value);
+
+            while (!minima_.empty() && !(minima_.back().value < value))
+            {
+                minima_.pop_back();
+            }
+            minima_.push_back(Candidate{sequence, value});
+            while (!maxima_.empty() && !(value < maxima_.back().value))
+            {
+                maxima_.pop_back();
+            }
+            maxima_.push_back(Candidate{sequence, value});
+
+            const real_type x = static_cast<real_type>(value);
+            sum_ += x;
+            const real_type delta = x - mean_;
+            mean_ += delta / static_cast<real_type>(window_.size());
+            m2_ += delta * (x - mean_);
+        }
+
+        void pop_front()
+        {
+            if (!window_.empty())
+            {
+                evict_oldest();
+            }
+        }
+
+        void clear()
+        {
+            oldest_ += window_.size();
+            window_.clear();
+            minima_.clear();
+            maxima_.clear();
+            sum_ = mean_ = m2_ = 0;
+        }
+
+        size_type size() const
+        {
+            return window_.size();
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        bool empty() const
+        {
+            return window_.empty();
+        }
+
+        bool full() const
+        {
+            return window_.full();
+        }
+
+        const_reference front() const
+        {
+            return window_.front();
+        }
+
+        const_reference back() const
+        {
+            return window_.back();
+        }
+
+        const_reference operator[](size_type index) const
+        {
+            return window_[index];
+        }
+
+        const CircularBuffer<T, Size> &window() const
+        {
+            return window_;
+        }
+
+        const_iterator begin() const
+        {
+            return window_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return window_.end();
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return window_.rbegin();
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return window_.rend();
+        }
+
+        real_type sum() const
+        {
+            return sum_;
+        }
+
+        // 0 for an empty window
+        real_type mean() const
+        {
+            return mean_;
+        }
+
+        // Population variance, 0 for an empty window
+        real_type variance() const
+        {
+            return window_.empty() ? 0 : m2_ / static_cast<real_type>(window_.size());
+        }
+
+        // Unbiased estimate, 0 for fewer than two samples
+        real_type sample_variance() const
+        {
+            return window_.size() < 2 ? 0 : m2_ / static_cast<real_type>(window_.size() - 1);
+        }
+
+        // The window must not be empty
+        T minimum() const
+        {
+            return minima_.front().value;
+        }
+
+        // The window must not be empty
+        T maximum() const
+        {
+            return maxima_.front().value;
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_SLIDINGWINDOW_HPP
@@ -0,0 +1,257 @@
+#ifndef CXXCIRCULARBUFFER_SOACIRCULARBUFFER_HPP
+#define CXXCIRCULARBUFFER_SOACIRCULARBUFFER_HPP
+
+#include <CXXCircularBuffer/CircularBufferIterator.hpp>
+#include <CXXCircularBuffer/Common.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace CXXCircularBuffer
+{
+    namespace detail
+    {
+        // Storage of one field of a SoACircularBuffer: Size slots of T, with the
+        // slot access RingIterator needs
+        template <typename T, std::size_t Size>
+        class SoAColumn
+        {
+        private:
+            UninitializedArray<T, Size> slots_;
+
+            template <typename, bool>
+            friend class RingIterator;
+
+            const T &slot(std::size_t index) const
+            {
+                return slots_[index];
+            }
+
+            std::size_t step(std::size_t index, std::ptrdiff_t n) const
+            {
+                return RingIndex<Size>::step(index, n);
+            }
+
+        public:
+            typedef T value_type;
+
+            SoAColumn() = default;
+
+            SoAColumn(const SoAColumn &other)
+            {
+                *this = other;
+            }
+
+            SoAColumn &operator=(const SoAColumn &other)
+            {
+                std::memcpy(static_cast<void *>(slots_.data()), other.slots_.data(), sizeof(T) * Size);
+                return *this;
+            }
+
+            T *data() noexcept { return slots_.data(); }
+            const T *data() const noexcept { return slots_.data(); }
+        };
+    } // namespace detail
+
+    // Ring of Size records whose fields are stored struct-of-arrays: field I
+    // of every record lives in its own contiguous array, and all fields share
+    // a single head and tail. A scan of one field through field<I>() touches
+    // only that field's bytes, instead of dragging whole records through the
+    // cache as CircularBuffer<Record, Size> does.
+    //
+    // Like CircularBuffer, a push into a full buffer overwrites the oldest
+    // record. Fields must be trivially copyable.
+    template <size_t Size, typename... Fields>
+    class SoACircularBuffer
+    {
+        static_assert(Size > 0, "SoACircularBuffer size must be greater than zero");
+        static_assert(sizeof...(Fields) > 0, "SoACircularBuffer requires at least one field");
+        static_assert(std::conjunction<std::is_trivially_copyable<Fields>...>::value,
+                      "SoACircularBuffer requires trivially copyable fields");
+
+    private:
+        typedef detail::RingIndex<Size> Index;
+
+        std::tuple<detail::SoAColumn<Fields, Size>...> columns_;
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+
+        template <std::size_t... I>
+        void store(std::size_t slot, std::index_sequence<I...>, const Fields &...values)
+        {
+            ((std::get<I>(columns_).data()[slot] = values), ...);
+        }
+
+        template <std::size_t... I>
+        std::tuple<Fields...> load(std::size_t slot, std::index_sequence<I...>) const
+        {
+            return std::tuple<Fields...>(std::get<I>(columns_).data()[slot]...);
+        }
+
+    public:
+        typedef std::tuple<Fields...> value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <std::size_t I>
+        using field_type = typename std::tuple_element<I, value_type>::type;
+
+        template <std::size_t I>
+        using field_iterator = detail::RingIterator<detail::SoAColumn<field_type<I>, Size>, false>;
+
+        // The elements of one field, oldest first, valid until the buffer is
+        // next modified
+        template <std::size_t I>
+        class FieldView
+        {
+        private:
+            field_iterator<I> begin_;
+            field_iterator<I> end_;
+            Segments<const field_type<I>> segments_;
+
+        public:
+            typedef field_type<I> value_type;
+            typedef field_iterator<I> const_iterator;
+            typedef size_t size_type;
+
+            FieldView(field_iterator<I> begin, field_iterator<I> end, Segments<const field_type<I>> segments)
+                : begin_(begin), end_(end), segments_(segments)
+            {
+            }
+
+            const_iterator begin() const { return begin_; }
+            const_iterator end() const { return end_; }
+            size_type size() const { return segments_.size(); }
+            bool empty() const { return segments_.empty(); }
+
+            const value_type &operator[](size_type index) const
+            {
+                return segments_[index];
+            }
+
+            // The contiguous runs, for loops the compiler can vectorize
+            Segments<const value_type> segments() const
+            {
+                return segments_;
+            }
+        };
+
+        SoACircularBuffer() = default;
+
+        size_type size() const
+        {
+            return Index::distance(tail_, head_);
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        bool empty() const
+        {
+            return head_ == tail_;
+        }
+
+        bool full() const
+        {
+            return size() == Size;
+        }
+
+        void push_back(const Fields &...values)
+        {
+            if (full())
+            {
+                tail_ = Index::advance(tail_, 1);
+            }
+            store(Index::slot(head_), std::index_sequence_for<Fields...>(), values...);
+            head_ = Index::advance(head_, 1);
+        }
+
+        void pop_front()
+        {
+            if (!empty())
+            {
+                tail_ = Index::advance(tail_, 1);
+            }
+        }
+
+        // Removes the count oldest records, or all of them if fewer
+        void pop_front_n(size_type count)
+        {
+            const std::size_t used = size();
+            tail_ = Index::advance(tail_, count < used ? count : used);
+        }
+
+        void clear()
+        {
+            head_ = tail_ = 0;
+        }
+
+        // Gathers the record at index, 0 being the oldest
+        value_type operator[](size_type index) const
+        {
+            return load(Index::slot(Index::advance(tail_, index)), std::index_sequence_for<Fields...>());
+        }
+
+        value_type front() const
+        {
+            return (*this)[0];
+        }
+
+        value_type back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+        // Field I of the record at index, 0 being the oldest
+        template <std::size_t I>
+        field_type<I> &get(size_type index)
+        {
+            return std::get<I>(columns_).data()[Index::slot(Index::advance(tail_, index))];
+        }
+
+        template <std::size_t I>
+        const field_type<I> &get(size_type index) const
+        {
+            return std::get<I>(columns_).data()[Index::slot(Index::advance(tail_, index))];
+        }
+
+        // Field I of every record, split where the storage wraps
+        template <std::size_t I>
+        Segments<field_type<I>> segments()
+        {
+            field_type<I> *data = std::get<I>(columns_).data();
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t used = size();
+            const std::size_t first = used < Size - start ? used : Size - start;
+            return Segments<field_type<I>>{Span<field_type<I>>(data + start, first),
+                                           Span<field_type<I>>(data, used - first)};
+        }
+
+        template <std::size_t I>
+        Segments<const field_type<I>> segments() const
+        {
+            const field_type<I> *data = std::get<I>(columns_).data();
+            const std::size_t start = Index::slot(tail_);
+            const std::size_t used = size();
+            const std::size_t first = used < Size - start ? used : Size - start;
+            return Segments<const field_type<I>>{Span<const field_type<I>>(data + start, first),
+                                                 Span<const field_type<I>>(data, used - first)};
+        }
+
+        template <std::size_t I>
+        FieldView<I> field() const
+        {
+            const detail::SoAColumn<field_type<I>, Size> *column = &std::get<I>(columns_);
+            return FieldView<I>(field_iterator<I>(column, Index::slot(tail_), 0),
+                                field_iterator<I>(column, Index::slot(head_), size()), segments<I>());
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_SOACIRCULARBUFFER_HPP
@@ -0,0 +1,103 @@
+#ifndef CXXCIRCULARBUFFER_SPAN_HPP
+#define CXXCIRCULARBUFFER_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace CXXCircularBuffer
+{
+
+    // Non-owning view over a contiguous run of elements, a minimal stand-in
+    // for C++20 std::span
+    template <typename T>
+    class Span
+    {
+    private:
+        T *data_;
+        std::size_t size_;
+
+    public:
+        typedef T element_type;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef T *pointer;
+        typedef T &reference;
+        typedef T *iterator;
+        typedef std::reverse_iterator<T *> reverse_iterator;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        constexpr Span() noexcept : data_(nullptr), size_(0) {}
+
+        constexpr Span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+        template <std::size_t N>
+        constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+        // Any contiguous container exposing data() and size(), e.g. std::vector
+        template <typename Container,
+                  typename = typename std::enable_if<
+                      !std::is_same<typename std::remove_cv<Container>::type, Span>::value &&
+                      std::is_convertible<decltype(std::declval<Container &>().data()), T *>::value>::type>
+        constexpr Span(Container &container) : data_(container.data()), size_(container.size())
+        {
+        }
+
+        // Span<T> converts to Span<const T>
+        template <typename U,
+                  typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+        constexpr Span(const Span<U> &other) noexcept : data_(other.data()), size_(other.size())
+        {
+        }
+
+        constexpr pointer data() const noexcept { return data_; }
+        constexpr size_type size() const noexcept { return size_; }
+        constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr iterator begin() const noexcept { return data_; }
+        constexpr iterator end() const noexcept { return data_ + size_; }
+        reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+        constexpr reference operator[](size_type index) const { return data_[index]; }
+        constexpr reference front() const { return data_[0]; }
+        constexpr reference back() const { return data_[size_ - 1]; }
+
+        constexpr Span first(size_type count) const { return Span(data_, count); }
+        constexpr Span last(size_type count) const { return Span(data_ + size_ - count, count); }
+        constexpr Span subspan(size_type offset, size_type count) const { return Span(data_ + offset, count); }
+    };
+
+    // Run of ring slots split where the storage wraps: one is the part up to
+    // the end of the storage, two the part continuing from its beginning
+    // (empty when the run does not wrap)
+    template <typename T>
+    struct Segments
+    {
+        Span<T> one;
+        Span<T> two;
+
+        constexpr std::size_t size() const noexcept { return one.size() + two.size(); }
+        constexpr bool empty() const noexcept { return one.empty() && two.empty(); }
+
+        constexpr T &operator[](std::size_t index) const
+        {
+            return index < one.size() ? one[index] : two[index - one.size()];
+        }
+
+        // The count elements starting at offset, still split where the storage
+        // wraps
+        constexpr Segments subsegments(std::size_t offset, std::size_t count) const
+        {
+            if (offset >= one.size())
+            {
+                return Segments{two.subspan(offset - one.size(), count), Span<T>()};
+            }
+            const std::size_t first = count < one.size() - offset ? count : one.size() - offset;
+            return Segments{one.subspan(offset, first), two.first(count - first)};
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_SPAN_HPP
@@ -0,0 +1,217 @@
+#ifndef CXXCIRCULARBUFFER_STATISTICS_HPP
+#define CXXCIRCULARBUFFER_STATISTICS_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace CXXCircularBuffer
+{
+
+    // Snapshot of the counters of a buffer instantiated with statistics
+    // enabled, returned by its statistics() member
+    struct BufferStatistics
+    {
+        // Elements stored, including the ones that replaced an older element
+        std::uint64_t pushes = 0;
+        // Elements removed by a consumer (clear() is not counted)
+        std::uint64_t pops = 0;
+        // Elements lost because a newer one replaced them
+        std::uint64_t overwrites = 0;
+        // Elements refused because the buffer was full
+        std::uint64_t rejections = 0;
+        // Largest size() observed after a push
+        std::size_t high_water_mark = 0;
+        // Total time the buffer spent full, including the current period
+        std::chrono::nanoseconds time_full{0};
+    };
+
+    namespace detail
+    {
+        inline std::int64_t statistics_now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        // Counters a buffer derives from privately, so that the disabled variant
+        // takes no space; every member of the disabled variant is an empty
+        // inline function the optimizer removes. Concurrent counters are relaxed
+        // atomics: they are only read as statistics and order nothing.
+        template <bool Enabled, bool Concurrent = false>
+        class StatisticsCounters
+        {
+        protected:
+            constexpr void record_push(std::size_t, std::size_t) {}
+            constexpr void record_pop(std::size_t) {}
+            constexpr void record_overwrite(std::size_t) {}
+            constexpr void record_rejection(std::size_t) {}
+            constexpr void record_full() {}
+            constexpr void record_not_full() {}
+        };
+
+        template <>
+        class StatisticsCounters<true, false>
+        {
+        private:
+            BufferStatistics counters_;
+            // Time the buffer became full, 0 while it is not
+            std::int64_t full_since_ = 0;
+
+        protected:
+            void record_push(std::size_t count, std::size_t size)
+            {
+                counters_.pushes += count;
+                counters_.high_water_mark = size > counters_.high_water_mark ? size : counters_.high_water_mark;
+            }
+
+            void record_pop(std::size_t count)
+            {
+                counters_.pops += count;
+            }
+
+            void record_overwrite(std::size_t count)
+            {
+                counters_.overwrites += count;
+            }
+
+            void record_rejection(std::size_t count)
+            {
+                counters_.rejections += count;
+            }
+
+            void record_full()
+            {
+                if (full_since_ == 0)
+                {
+                    full_since_ = statistics_now();
+                }
+            }
+
+            void record_not_full()
+            {
+                if (full_since_ != 0)
+                {
+                    counters_.time_full += std::chrono::nanoseconds(statistics_now() - full_since_);
+                    full_since_ = 0;
+                }
+            }
+
+            BufferStatistics statistics() const
+            {
+                BufferStatistics snapshot = counters_;
+                if (full_since_ != 0)
+                {
+                    snapshot.time_full += std::chrono::nanoseconds(statistics_now() - full_since_);
+                }
+                return snapshot;
+            }
+
+            void reset_statistics()
+            {
+                counters_ = BufferStatistics();
+                full_since_ = 0;
+            }
+        };
+
+        template <>
+        class StatisticsCounters<true, true>
+        {
+        private:
+            // Producer side
+            std::atomic<std::uint64_t> pushes_{0};
+            std::atomic<std::uint64_t> overwrites_{0};
+            std::atomic<std::uint64_t> rejections_{0};
+            std::atomic<std::size_t> high_water_mark_{0};
+            std::atomic<std::int64_t> time_full_{0};
+            std::atomic<std::int64_t> full_since_{0};
+            // Consumer side, on its own cache line
+            alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> pops_{0};
+
+        protected:
+            void record_push(std::size_t count, std::size_t size)
+            {
+                pushes_.fetch_add(count, std::memory_order_relaxed);
+                std::size_t mark = high_water_mark_.load(std::memory_order_relaxed);
+                while (size > mark &&
+                       !high_water_mark_.compare_exchange_weak(mark, size, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            void record_pop(std::size_t count)
+            {
+                pops_.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            void record_overwrite(std::size_t count)
+            {
+                overwrites_.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            void record_rejection(std::size_t count)
+            {
+                rejections_.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            // Producers cannot see the consumer free a slot, so a concurrent
+            // buffer counts as full from a rejected push to the next accepted one
+            void record_full()
+            {
+                if (full_since_.load(std::memory_order_relaxed) == 0)
+                {
+                    std::int64_t expected = 0;
+                    full_since_.compare_exchange_strong(expected, statistics_now(), std::memory_order_relaxed);
+                }
+            }
+
+            void record_not_full()
+            {
+                if (full_since_.load(std::memory_order_relaxed) != 0)
+                {
+                    const std::int64_t since = full_since_.exchange(0, std::memory_order_relaxed);
+                    if (since != 0)
+                    {
+                        time_full_.fetch_add(statistics_now() - since, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // Each counter is read atomically, but not all of them at once
+            BufferStatistics statistics() const
+            {
+                BufferStatistics snapshot;
+                snapshot.pushes = pushes_.load(std::memory_order_relaxed);
+                snapshot.pops = pops_.load(std::memory_order_relaxed);
+                snapshot.overwrites = overwrites_.load(std::memory_order_relaxed);
+                snapshot.rejections = rejections_.load(std::memory_order_relaxed);
+                snapshot.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+                std::int64_t time_full = time_full_.load(std::memory_order_relaxed);
+                const std::int64_t since = full_since_.load(std::memory_order_relaxed);
+                if (since != 0)
+                {
+                    time_full += statistics_now() - since;
+                }
+                snapshot.time_full = std::chrono::nanoseconds(time_full);
+                return snapshot;
+            }
+
+            void reset_statistics()
+            {
+                pushes_.store(0, std::memory_order_relaxed);
+                pops_.store(0, std::memory_order_relaxed);
+                overwrites_.store(0, std::memory_order_relaxed);
+                rejections_.store(0, std::memory_order_relaxed);
+                high_water_mark_.store(0, std::memory_order_relaxed);
+                time_full_.store(0, std::memory_order_relaxed);
+                full_since_.store(0, std::memory_order_relaxed);
+            }
+        };
+    } // namespace detail
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_STATISTICS_HPP
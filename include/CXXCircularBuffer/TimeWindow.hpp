@@ -0,0 +1,181 @@
+#ifndef CXXCIRCULARBUFFER_TIMEWINDOW_HPP
+#define CXXCIRCULARBUFFER_TIMEWINDOW_HPP
+
+#include <CXXCircularBuffer/SoACircularBuffer.hpp>
+#include <CXXCircularBuffer/Span.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace CXXCircularBuffer
+{
+
+    // Ring of up to Size timestamped samples holding the ones no older than a
+    // duration, for windows such as "the last 5 seconds". Timestamps and
+    // values are kept in separate arrays sharing one head and tail (see
+    // SoACircularBuffer), so the ordered timestamps can be binary searched:
+    // lower_bound(), expiry and time-range queries are O(log n), and ranges
+    // come back as segment views of the values, without copying.
+    //
+    // Timestamps must be pushed in non-decreasing order. A push evicts the
+    // expired samples first, then the oldest one if the ring is still full.
+    // T must be trivially copyable.
+    template <typename T, size_t Size, typename Clock = std::chrono::steady_clock>
+    class TimeWindow
+    {
+    public:
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef typename Clock::time_point time_point;
+        typedef typename Clock::duration duration;
+
+    private:
+        SoACircularBuffer<Size, time_point, T> samples_;
+        duration window_;
+
+        // Index of the first sample for which before(timestamp) is false, the
+        // samples being ordered by before
+        template <typename Before>
+        size_type partition_point(Before before) const
+        {
+            const Segments<const time_point> stamps = samples_.template segments<0>();
+            // Only one segment can hold the bound: the second when the whole
+            // first one comes before it
+            if (stamps.one.empty() || before(stamps.one.back()))
+            {
+                return stamps.one.size() +
+                       static_cast<size_type>(std::partition_point(stamps.two.begin(), stamps.two.end(), before) -
+                                              stamps.two.begin());
+            }
+            return static_cast<size_type>(std::partition_point(stamps.one.begin(), stamps.one.end(), before) -
+                                          stamps.one.begin());
+        }
+
+    public:
+        explicit TimeWindow(duration window) : window_(window) {}
+
+        duration window() const
+        {
+            return window_;
+        }
+
+        void set_window(duration window)
+        {
+            window_ = window;
+        }
+
+        // Appends value stamped with timestamp, which must not be older than
+        // the newest sample
+        void push_back(time_point timestamp, const T &value)
+        {
+            expire(timestamp);
+            samples_.push_back(timestamp, value);
+        }
+
+        void push_back(const T &value)
+        {
+            push_back(Clock::now(), value);
+        }
+
+        // Removes the samples older than now - window() and returns how many
+        size_type expire(time_point now)
+        {
+            const size_type expired = lower_bound(now - window_);
+            samples_.pop_front_n(expired);
+            return expired;
+        }
+
+        size_type expire()
+        {
+            return expire(Clock::now());
+        }
+
+        void pop_front()
+        {
+            samples_.pop_front();
+        }
+
+        void clear()
+        {
+            samples_.clear();
+        }
+
+        size_type size() const
+        {
+            return samples_.size();
+        }
+
+        size_type capacity() const
+        {
+            return Size;
+        }
+
+        bool empty() const
+        {
+            return samples_.empty();
+        }
+
+        bool full() const
+        {
+            return samples_.full();
+        }
+
+        // Value of the sample at index, 0 being the oldest
+        const_reference operator[](size_type index) const
+        {
+            return samples_.template get<1>(index);
+        }
+
+        time_point timestamp(size_type index) const
+        {
+            return samples_.template get<0>(index);
+        }
+
+        const_reference front() const
+        {
+            return (*this)[0];
+        }
+
+        const_reference back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+        // Index of the oldest sample stamped at or after timestamp, size() if
+        // there is none
+        size_type lower_bound(time_point timestamp) const
+        {
+            return partition_point([timestamp](time_point stamp) { return stamp < timestamp; });
+        }
+
+        // Index of the oldest sample stamped after timestamp, size() if there
+        // is none
+        size_type upper_bound(time_point timestamp) const
+        {
+            return partition_point([timestamp](time_point stamp) { return !(timestamp < stamp); });
+        }
+
+        // Values of every sample, oldest first
+        Segments<const T> values() const
+        {
+            return samples_.template segments<1>();
+        }
+
+        Segments<const time_point> timestamps() const
+        {
+            return samples_.template segments<0>();
+        }
+
+        // Values of the samples stamped in [from, to)
+        Segments<const T> range(time_point from, time_point to) const
+        {
+            const size_type first = lower_bound(from);
+            const size_type last = lower_bound(to);
+            return values().subsegments(first, last > first ? last - first : 0);
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_TIMEWINDOW_HPP
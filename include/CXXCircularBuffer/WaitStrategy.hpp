@@ -0,0 +1,172 @@
+#ifndef CXXCIRCULARBUFFER_WAITSTRATEGY_HPP
+#define CXXCIRCULARBUFFER_WAITSTRATEGY_HPP
+
+#include <CXXCircularBuffer/Common.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace CXXCircularBuffer
+{
+
+    // How a thread waits for a condition of a concurrent buffer to change.
+    // A strategy provides
+    //     template <typename Predicate> void wait(Predicate ready);
+    //     template <typename Predicate, typename Clock, typename Duration>
+    //     bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration> &deadline);
+    //     void notify();
+    // wait() returns once ready() returned true, wait_until() returns false if
+    // the deadline passed first. notify() is called after every change that
+    // could make a waiter's predicate true.
+
+    // Never gives up the core: the lowest wake-up latency, at the price of one
+    // fully busy core per waiting thread
+    struct BusySpinWait
+    {
+        template <typename Predicate>
+        void wait(Predicate ready)
+        {
+            while (!ready())
+            {
+                detail::cpu_relax();
+            }
+        }
+
+        template <typename Predicate, typename Clock, typename Duration>
+        bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            while (!ready())
+            {
+                if (Clock::now() >= deadline)
+                {
+                    return false;
+                }
+                detail::cpu_relax();
+            }
+            return true;
+        }
+
+        void notify() {}
+    };
+
+    // Spins for Spins attempts, then yields the core between attempts. Short
+    // waits stay cheap while long ones leave room for other threads.
+    template <unsigned Spins = 128>
+    struct SpinYieldWait
+    {
+        template <typename Predicate>
+        void wait(Predicate ready)
+        {
+            for (unsigned attempt = 0; !ready(); ++attempt)
+            {
+                pause(attempt);
+            }
+        }
+
+        template <typename Predicate, typename Clock, typename Duration>
+        bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            for (unsigned attempt = 0; !ready(); ++attempt)
+            {
+                if (Clock::now() >= deadline)
+                {
+                    return false;
+                }
+                pause(attempt);
+            }
+            return true;
+        }
+
+        void notify() {}
+
+    private:
+        static void pause(unsigned attempt)
+        {
+            if (attempt < Spins)
+            {
+                detail::cpu_relax();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    // Puts waiting threads to sleep on a condition variable (a futex on Linux)
+    // after one last check. notify() only takes the lock when a thread is
+    // actually parked, so the uncontended paths stay lock-free.
+    class ParkingWait
+    {
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::atomic<unsigned> waiters_{0};
+
+        // Orders the waiter registration before the predicate check, pairing
+        // with the fence in notify(): either the waiter sees the change or the
+        // notifier sees the waiter
+        void enter()
+        {
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void leave()
+        {
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+    public:
+        template <typename Predicate>
+        void wait(Predicate ready)
+        {
+            if (ready())
+            {
+                return;
+            }
+            enter();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, ready);
+            }
+            leave();
+        }
+
+        template <typename Predicate, typename Clock, typename Duration>
+        bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration> &deadline)
+        {
+            if (ready())
+            {
+                return true;
+            }
+            enter();
+            bool result;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                result = condition_.wait_until(lock, deadline, ready);
+            }
+            leave();
+            return result;
+        }
+
+        void notify()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters_.load(std::memory_order_relaxed) != 0)
+            {
+                // Taking the lock makes sure a waiter that has checked its
+                // predicate is already asleep and will receive the notification
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                }
+                condition_.notify_one();
+            }
+        }
+    };
+} // namespace CXXCircularBuffer
+
+#endif // CXXCIRCULARBUFFER_WAITSTRATEGY_HPP
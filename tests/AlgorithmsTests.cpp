@@ -0,0 +1,96 @@
+#include <CXXCircularBuffer/Algorithms.hpp>
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <CXXCircularBuffer/DynamicCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // A wrapped buffer holding 3..9: slots 3..7 and then 0..1
+    CircularBuffer<int, 7> wrapped_sequence()
+    {
+        CircularBuffer<int, 7> buffer;
+        for (int i = 1; i <= 9; ++i)
+        {
+            buffer.push_back(i);
+        }
+        return buffer;
+    }
+}
+
+TEST(AlgorithmsTest, ForEachSegment)
+{
+    CircularBuffer<int, 7> buffer = wrapped_sequence();
+    std::vector<std::size_t> sizes;
+    for_each_segment(buffer, [&sizes](Span<int> segment) {
+        sizes.push_back(segment.size());
+        for (int &value : segment)
+        {
+            value *= 10;
+        }
+    });
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{5, 2}));
+    EXPECT_EQ(buffer.front(), 30);
+    EXPECT_EQ(buffer.back(), 90);
+
+    int total = 0;
+    for_each_segment(buffer.peek(3), [&total](Span<const int> segment) {
+        total = std::accumulate(segment.begin(), segment.end(), total);
+    });
+    EXPECT_EQ(total, 120);
+
+    CircularBuffer<int, 7> empty;
+    for_each_segment(empty, [&sizes](Span<int>) { sizes.clear(); });
+    EXPECT_EQ(sizes.size(), 2);
+}
+
+TEST(AlgorithmsTest, MatchIteratorResults)
+{
+    const CircularBuffer<int, 7> buffer = wrapped_sequence();
+    const std::vector<int> expected(buffer.begin(), buffer.end());
+
+    std::vector<int> copied;
+    copy(buffer, std::back_inserter(copied));
+    EXPECT_EQ(copied, expected);
+
+    std::vector<std::string> names(buffer.size());
+    EXPECT_EQ(transform(buffer, names.begin(), [](int value) { return std::to_string(value); }), names.end());
+    EXPECT_EQ(names.front(), "3");
+    EXPECT_EQ(names.back(), "9");
+
+    EXPECT_EQ(accumulate(buffer, 0), 42);
+    EXPECT_EQ(accumulate(buffer, 1L, [](long product, int value) { return product * value; }), 181440L);
+
+    EXPECT_EQ(count(buffer, 8), 1);
+    EXPECT_EQ(count(buffer, 1), 0);
+
+    EXPECT_EQ(find(buffer, 5), buffer.begin() + 2);
+    EXPECT_EQ(find(buffer, 9), buffer.begin() + 6);
+    EXPECT_EQ(find(buffer, 2), buffer.end());
+}
+
+TEST(AlgorithmsTest, LowerBoundAcrossSegments)
+{
+    const CircularBuffer<int, 7> buffer = wrapped_sequence();
+    for (int value = 0; value <= 11; ++value)
+    {
+        EXPECT_EQ(lower_bound(buffer, value), std::lower_bound(buffer.begin(), buffer.end(), value)) << value;
+    }
+    EXPECT_EQ(lower_bound(buffer, 7, std::less<int>()), buffer.begin() + 4);
+
+    DynamicCircularBuffer<int> dynamic(4);
+    EXPECT_EQ(lower_bound(dynamic, 1), dynamic.end());
+    for (int i = 0; i < 6; ++i)
+    {
+        dynamic.push_back(i * 2);
+    }
+    EXPECT_EQ(*lower_bound(dynamic, 5), 6);
+    EXPECT_EQ(lower_bound(dynamic, 11), dynamic.end());
+}
@@ -0,0 +1,221 @@
+#include <CXXCircularBuffer/AsyncChannel.hpp>
+#include <gtest/gtest.h>
+
+#if defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // Eager fire-and-forget coroutine: runs until its first suspension when
+    // called, and frees itself when it finishes
+    struct Task
+    {
+        struct promise_type
+        {
+            Task get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    template <typename Channel, typename Counter>
+    Task produce(Channel &channel, int first, int count, Counter &finished)
+    {
+        for (int i = first; i < first + count; ++i)
+        {
+            co_await channel.push(i);
+        }
+        ++finished;
+    }
+
+    template <typename Channel>
+    Task consume(Channel &channel, std::vector<int> &received)
+    {
+        while (std::optional<int> item = co_await channel.pop())
+        {
+            received.push_back(*item);
+        }
+    }
+
+    // Pipeline stage adding one to every element
+    Task relay(AsyncChannel<int, 1> &in, AsyncChannel<int, 1> &out)
+    {
+        while (std::optional<int> item = co_await in.pop())
+        {
+            co_await out.push(*item + 1);
+        }
+        out.close();
+    }
+}
+
+TEST(AsyncChannelTest, SuspendsAndResumesOppositeSide)
+{
+    ReadyQueue scheduler;
+    AsyncChannel<int, 4> channel(scheduler);
+    std::vector<int> received;
+    int finished = 0;
+
+    // The producer fills the ring and suspends on the fifth push
+    produce(channel, 0, 100, finished);
+    EXPECT_EQ(finished, 0);
+    EXPECT_EQ(channel.size(), 4);
+
+    // The consumer's first pop frees a slot and posts the producer; the two
+    // then take turns through the scheduler until the consumer waits on the
+    // empty channel
+    consume(channel, received);
+    EXPECT_GT(scheduler.run(), 0);
+    EXPECT_EQ(finished, 1);
+    EXPECT_EQ(received.size(), 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+
+    // A waiting consumer gets the element handed over directly, and runs
+    // once the scheduler resumes it
+    std::optional<int> item = 7;
+    EXPECT_TRUE(channel.try_push(*item));
+    EXPECT_EQ(channel.size(), 0);
+    EXPECT_EQ(received.size(), 100);
+    EXPECT_EQ(scheduler.run(), 1);
+    EXPECT_EQ(received.back(), 7);
+
+    // close() posts the consumer, which gets an empty optional and ends
+    channel.close();
+    EXPECT_TRUE(channel.closed());
+    EXPECT_EQ(scheduler.run(), 1);
+    EXPECT_EQ(received.size(), 101);
+}
+
+TEST(AsyncChannelTest, CloseWakesPushersAndKeepsElements)
+{
+    ReadyQueue scheduler;
+    AsyncChannel<std::string, 2> channel(scheduler);
+    std::optional<bool> accepted;
+    auto pusher = [&channel, &accepted](std::string item) -> Task { accepted = co_await channel.push(std::move(item)); };
+
+    pusher("a");
+    pusher("b");
+    EXPECT_EQ(accepted, true);
+    accepted.reset();
+    pusher("c");
+    EXPECT_FALSE(accepted.has_value());
+
+    channel.close();
+    EXPECT_FALSE(accepted.has_value());
+    scheduler.run();
+    EXPECT_EQ(accepted, false);
+
+    // Elements accepted before close() can still be popped
+    EXPECT_EQ(channel.try_pop(), "a");
+    EXPECT_EQ(channel.try_pop(), "b");
+    EXPECT_FALSE(channel.try_pop().has_value());
+
+    std::string late = "d";
+    EXPECT_FALSE(channel.try_push(late));
+    EXPECT_EQ(late, "d");
+}
+
+TEST(AsyncChannelTest, ManyProducersAcrossThreads)
+{
+    constexpr int producers = 4;
+    constexpr int count = 20000;
+    ReadyQueue scheduler;
+    AsyncChannel<int, 16> channel(scheduler);
+    std::vector<int> received;
+    std::atomic<int> finished{0};
+
+    // Each coroutine starts on its own thread, and every thread then runs
+    // the shared scheduler, so a coroutine continues on whichever thread
+    // picks it up
+    auto run = [&scheduler, &finished]() {
+        while (finished.load() != producers)
+        {
+            if (scheduler.run() == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.emplace_back([&channel, &received, &run]() {
+        consume(channel, received);
+        run();
+    });
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&channel, &finished, &run, p]() {
+            produce(channel, p * count, count, finished);
+            run();
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // The consumer drains what is left, then ends on the closed channel
+    channel.close();
+    scheduler.run();
+
+    ASSERT_EQ(received.size(), static_cast<std::size_t>(producers * count));
+    std::vector<int> next(producers);
+    for (int p = 0; p < producers; ++p)
+    {
+        next[p] = p * count;
+    }
+    for (int value : received)
+    {
+        // Each producer's elements arrive in order
+        ASSERT_EQ(value, next[value / count]++);
+    }
+}
+
+TEST(AsyncChannelTest, LongPipelineDoesNotNest)
+{
+    // Waking a stage used to resume it inside the push that satisfied it,
+    // nesting every stage of the chain on one stack
+    constexpr int stages = 10000;
+    ReadyQueue scheduler;
+    std::vector<std::unique_ptr<AsyncChannel<int, 1>>> channels;
+    for (int i = 0; i <= stages; ++i)
+    {
+        channels.push_back(std::make_unique<AsyncChannel<int, 1>>(scheduler));
+    }
+    std::vector<int> received;
+    consume(*channels.back(), received);
+    for (int i = 0; i < stages; ++i)
+    {
+        relay(*channels[i], *channels[i + 1]);
+    }
+
+    int finished = 0;
+    produce(*channels.front(), 0, 10, finished);
+    scheduler.run();
+    EXPECT_EQ(finished, 1);
+
+    // Closing the head closes every stage in turn
+    channels.front()->close();
+    scheduler.run();
+    ASSERT_EQ(received.size(), 10);
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(received[i], i + stages);
+    }
+    EXPECT_TRUE(channels.back()->closed());
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <CXXCircularBuffer/BlockingCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    template <typename WaitStrategy>
+    void check_timeouts()
+    {
+        BlockingCircularBuffer<int, 2, WaitStrategy> buffer;
+        int value = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(buffer.pop_wait_for(value, std::chrono::milliseconds(20)));
+        EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+        buffer.push_wait(1);
+        EXPECT_TRUE(buffer.push_wait_for(2, std::chrono::milliseconds(20)));
+        EXPECT_FALSE(buffer.push_wait_for(3, std::chrono::milliseconds(20)));
+        EXPECT_FALSE(buffer.try_push(3));
+
+        EXPECT_TRUE(buffer.pop_wait_for(value, std::chrono::milliseconds(20)));
+        EXPECT_EQ(value, 1);
+        EXPECT_EQ(buffer.pop_wait(), 2);
+        EXPECT_TRUE(buffer.empty());
+    }
+
+    // Producers outpace the small buffer and consumers wait on an empty one,
+    // so both sides have to wait and be woken up many times
+    template <typename WaitStrategy>
+    void check_producers_and_consumers()
+    {
+        constexpr int producers = 2;
+        constexpr int consumers = 2;
+        constexpr int per_producer = 20000;
+        BlockingCircularBuffer<int, 4, WaitStrategy> buffer;
+        std::vector<long long> sums(consumers, 0);
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&buffer]()
+                                 {
+                for (int i = 1; i <= per_producer; ++i)
+                {
+                    buffer.push_wait(i);
+                } });
+        }
+        for (int c = 0; c < consumers; ++c)
+        {
+            threads.emplace_back([&buffer, &sums, c]()
+                                 {
+                for (int i = 0; i < per_producer * producers / consumers; ++i)
+                {
+                    sums[c] += buffer.pop_wait();
+                } });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        const long long expected = producers * static_cast<long long>(per_producer) * (per_producer + 1) / 2;
+        EXPECT_EQ(sums[0] + sums[1], expected);
+        EXPECT_TRUE(buffer.empty());
+    }
+}
+
+TEST(BlockingCircularBufferTest, TimeoutsBusySpin)
+{
+    check_timeouts<BusySpinWait>();
+}
+
+TEST(BlockingCircularBufferTest, TimeoutsSpinYield)
+{
+    check_timeouts<SpinYieldWait<>>();
+}
+
+TEST(BlockingCircularBufferTest, TimeoutsParking)
+{
+    check_timeouts<ParkingWait>();
+}
+
+TEST(BlockingCircularBufferTest, ProducersAndConsumersSpinYield)
+{
+    check_producers_and_consumers<SpinYieldWait<16>>();
+}
+
+TEST(BlockingCircularBufferTest, ProducersAndConsumersParking)
+{
+    check_producers_and_consumers<ParkingWait>();
+}
+
+TEST(BlockingCircularBufferTest, ParkedConsumerIsWokenUp)
+{
+    BlockingCircularBuffer<std::unique_ptr<int>, 2> buffer;
+
+    std::thread consumer([&buffer]()
+                         {
+        std::unique_ptr<int> item = buffer.pop_wait();
+        EXPECT_EQ(*item, 42); });
+
+    // Give the consumer time to park
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    buffer.push_wait(std::make_unique<int>(42));
+    consumer.join();
+
+    // A timed out push keeps the element
+    std::unique_ptr<int> item = std::make_unique<int>(1);
+    buffer.push_wait(std::make_unique<int>(2));
+    buffer.push_wait(std::make_unique<int>(3));
+    EXPECT_FALSE(buffer.push_wait_for(std::move(item), std::chrono::milliseconds(5)));
+    ASSERT_TRUE(item);
+    EXPECT_EQ(*item, 1);
+}
+
+TEST(BlockingCircularBufferTest, OverflowPolicies)
+{
+    BlockingCircularBuffer<int, 2, ParkingWait, OverflowPolicy::RejectNew> reject;
+    EXPECT_EQ(reject.push_back(1), PushStatus::Pushed);
+    EXPECT_EQ(reject.push_back(2), PushStatus::Pushed);
+    EXPECT_EQ(reject.push_back(3), PushStatus::Rejected);
+
+    BlockingCircularBuffer<int, 2, ParkingWait, OverflowPolicy::DropNewest> drop;
+    drop.push_back(1);
+    drop.push_back(2);
+    EXPECT_EQ(drop.push_back(3), PushStatus::Dropped);
+    EXPECT_EQ(drop.pop_wait(), 1);
+
+    BlockingCircularBuffer<int, 2, ParkingWait, OverflowPolicy::OverwriteOldest> overwrite;
+    overwrite.push_back(1);
+    overwrite.push_back(2);
+    EXPECT_EQ(overwrite.push_back(3), PushStatus::Overwritten);
+    EXPECT_EQ(overwrite.pop_wait(), 2);
+    EXPECT_EQ(overwrite.pop_wait(), 3);
+
+    // Block is the default: the push waits for the consumer
+    BlockingCircularBuffer<int, 2> block;
+    block.push_back(1);
+    block.push_back(2);
+    std::thread consumer([&block]()
+                         {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        EXPECT_EQ(block.pop_wait(), 1); });
+    EXPECT_EQ(block.push_back(3), PushStatus::Pushed);
+    consumer.join();
+    EXPECT_EQ(block.size(), 2);
+}
@@ -0,0 +1,184 @@
+#include <CXXCircularBuffer/BroadcastCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+TEST(BroadcastCircularBufferTest, EveryReaderSeesEveryElement)
+{
+    BroadcastCircularBuffer<std::string, 3, 2> buffer;
+    EXPECT_TRUE(buffer.try_push("a"));
+    EXPECT_TRUE(buffer.try_push("b"));
+
+    std::string item;
+    EXPECT_TRUE(buffer.try_read(0, item));
+    EXPECT_EQ(item, "a");
+    EXPECT_TRUE(buffer.try_read(0, item));
+    EXPECT_EQ(item, "b");
+    EXPECT_FALSE(buffer.try_read(0, item));
+
+    EXPECT_EQ(buffer.lag(0), 0u);
+    EXPECT_EQ(buffer.lag(1), 2u);
+    EXPECT_TRUE(buffer.try_read(1, item));
+    EXPECT_EQ(item, "a");
+}
+
+TEST(BroadcastCircularBufferTest, ProducerGatesOnSlowestReader)
+{
+    BroadcastCircularBuffer<int, 3, 2> buffer;
+    int item = 0;
+    for (int i = 1; i <= 3; ++i)
+    {
+        EXPECT_TRUE(buffer.try_push(i));
+        EXPECT_TRUE(buffer.try_read(0, item));
+    }
+
+    // Reader 1 has not read anything yet
+    EXPECT_FALSE(buffer.try_push(4));
+    EXPECT_TRUE(buffer.try_read(1, item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(buffer.try_push(4));
+    EXPECT_FALSE(buffer.try_push(5));
+
+    // Zero-copy reads across the wrap
+    Segments<const int> view = buffer.peek(1, 10);
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.one.size(), 2u);
+    EXPECT_EQ(view[0], 2);
+    EXPECT_EQ(view[2], 4);
+    buffer.consume(1, 3);
+    EXPECT_EQ(buffer.lag(1), 0u);
+    EXPECT_EQ(buffer.dropped(1), 0u);
+
+    EXPECT_TRUE(buffer.try_read(0, item));
+    EXPECT_EQ(item, 4);
+    EXPECT_TRUE(buffer.try_push(5));
+}
+
+TEST(BroadcastCircularBufferTest, DestroysStoredElements)
+{
+    std::shared_ptr<int> tracked = std::make_shared<int>(7);
+    {
+        BroadcastCircularBuffer<std::shared_ptr<int>, 4, 1> buffer;
+        buffer.try_push(tracked);
+        buffer.try_push(tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(BroadcastCircularBufferTest, LossyOverwritesAndReportsDrops)
+{
+    BroadcastCircularBuffer<int, 4, 2, BroadcastMode::Lossy> buffer;
+    for (int i = 0; i < 10; ++i)
+    {
+        buffer.push(i);
+    }
+
+    EXPECT_EQ(buffer.lag(0), 10u);
+    int item = -1;
+    EXPECT_TRUE(buffer.try_read(0, item));
+    // Elements 0 to 5 were overwritten
+    EXPECT_EQ(item, 6);
+    EXPECT_EQ(buffer.dropped(0), 6u);
+
+    EXPECT_TRUE(buffer.try_read(0, item));
+    EXPECT_EQ(item, 7);
+    EXPECT_EQ(buffer.lag(0), 2u);
+
+    // The other reader is independent
+    EXPECT_EQ(buffer.dropped(1), 0u);
+    EXPECT_TRUE(buffer.try_read(1, item));
+    EXPECT_EQ(item, 6);
+}
+
+TEST(BroadcastCircularBufferTest, GatedReadersAcrossThreads)
+{
+    constexpr int count = 50000;
+    constexpr std::size_t readers = 3;
+    BroadcastCircularBuffer<int, 64, readers> buffer;
+    std::vector<long long> sums(readers, 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&buffer, &sums, r]()
+                             {
+            int expected = 0;
+            int item = 0;
+            while (expected < count)
+            {
+                if (buffer.try_read(r, item))
+                {
+                    // In order and without gaps
+                    ASSERT_EQ(item, expected);
+                    sums[r] += item;
+                    ++expected;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        while (!buffer.try_push(i))
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (long long sum : sums)
+    {
+        EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+    }
+}
+
+TEST(BroadcastCircularBufferTest, LossyReadsAreNeverTorn)
+{
+    struct Sample
+    {
+        std::uint64_t sequence;
+        std::uint64_t check;
+    };
+    constexpr std::uint64_t count = 200000;
+    BroadcastCircularBuffer<Sample, 8, 1, BroadcastMode::Lossy> buffer;
+
+    std::thread producer([&buffer]()
+                         {
+        for (std::uint64_t i = 1; i <= count; ++i)
+        {
+            buffer.push(Sample{i, ~i});
+        } });
+
+    std::uint64_t last = 0;
+    std::uint64_t received = 0;
+    Sample sample{};
+    while (last < count)
+    {
+        if (buffer.try_read(0, sample))
+        {
+            ASSERT_EQ(sample.check, ~sample.sequence);
+            ASSERT_GT(sample.sequence, last);
+            last = sample.sequence;
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(received + buffer.dropped(0), count);
+}
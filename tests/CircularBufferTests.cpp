@@ -1,6 +1,16 @@
 #include <CXXCircularBuffer/CircularBuffer.hpp>
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 using namespace CXXCircularBuffer;
 
 TEST(CircularBufferTest, PushBackAndPopFront)
@@ -378,3 +388,693 @@ TEST(CircularBufferTest, ReverseIteratorOnEmptyBuffer)
 
     EXPECT_EQ(rit, rend); // Both should be equal for an empty buffer
 }
+
+TEST(CircularBufferTest, InlineStorage)
+{
+    // The elements are stored inside the object, without a vtable pointer
+    typedef CircularBuffer<int, 8> Buffer;
+    EXPECT_FALSE(std::is_polymorphic<Buffer>::value);
+    EXPECT_GE(sizeof(Buffer), 8 * sizeof(int));
+    EXPECT_LT(sizeof(Buffer), 8 * sizeof(int) + 4 * sizeof(std::size_t));
+}
+
+TEST(CircularBufferTest, CopyIsIndependent)
+{
+    CircularBuffer<int, 3> buffer;
+    buffer.push_back(1);
+    buffer.push_back(2);
+
+    CircularBuffer<int, 3> copy = buffer;
+    copy.push_back(3);
+    copy.push_back(4);
+
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[1], 2);
+
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy[0], 2);
+    EXPECT_EQ(copy[2], 4);
+}
+
+TEST(CircularBufferTest, CopyAndMoveTrivialElementsAcrossTheWrap)
+{
+    // Trivial elements are copied segment by segment: check both segments,
+    // for a trivial type and for a trivially copyable one with a constructor
+    struct Point
+    {
+        Point(int x_, int y_) : x(x_), y(y_) {}
+        int x;
+        int y;
+    };
+    CircularBuffer<int, 5> numbers;
+    CircularBuffer<Point, 5> points;
+    for (int i = 1; i <= 8; ++i)
+    {
+        numbers.push_back(i);
+        points.emplace_back(i, -i);
+    }
+    numbers.pop_front();
+    points.pop_front();
+    ASSERT_NE(numbers.array_two().size(), 0);
+
+    const CircularBuffer<int, 5> copy = numbers;
+    const CircularBuffer<int, 5> moved = CircularBuffer<int, 5>(numbers);
+    CircularBuffer<int, 5> assigned;
+    assigned.push_back(42);
+    assigned = copy;
+    const std::vector<int> expected{5, 6, 7, 8};
+    EXPECT_EQ(std::vector<int>(copy.begin(), copy.end()), expected);
+    EXPECT_EQ(std::vector<int>(moved.begin(), moved.end()), expected);
+    EXPECT_EQ(std::vector<int>(assigned.begin(), assigned.end()), expected);
+
+    CircularBuffer<Point, 5> point_copy = points;
+    CircularBuffer<Point, 5> point_moved = std::move(points);
+    EXPECT_TRUE(points.empty());
+    ASSERT_EQ(point_copy.size(), 4);
+    ASSERT_EQ(point_moved.size(), 4);
+    EXPECT_EQ(point_copy.front().x, 5);
+    EXPECT_EQ(point_moved.back().y, -8);
+    point_copy.push_back(Point(9, -9));
+    EXPECT_EQ(point_copy.front().x, 5);
+    EXPECT_EQ(point_moved.size(), 4);
+}
+
+TEST(CircularBufferTest, PowerOfTwoAndGeneralSizesAgree)
+{
+    CircularBuffer<int, 8> pow2;
+    CircularBuffer<int, 7> general;
+
+    // Run the counters around the ring many times, mixing pushes and pops
+    for (int i = 0; i < 1000; ++i)
+    {
+        pow2.push_back(i);
+        general.push_back(i);
+        if (i % 3 == 0)
+        {
+            pow2.pop_front();
+            general.pop_front();
+        }
+
+        ASSERT_EQ(pow2.back(), i);
+        ASSERT_EQ(general.back(), i);
+        ASSERT_LE(pow2.size(), 8u);
+        ASSERT_LE(general.size(), 7u);
+        for (std::size_t j = 0; j < general.size(); ++j)
+        {
+            ASSERT_EQ(general[j], i - static_cast<int>(general.size() - 1 - j));
+        }
+        for (std::size_t j = 0; j < pow2.size(); ++j)
+        {
+            ASSERT_EQ(pow2[j], i - static_cast<int>(pow2.size() - 1 - j));
+        }
+    }
+}
+
+TEST(CircularBufferTest, FullFunctionality)
+{
+    CircularBuffer<int, 3> buffer;
+
+    EXPECT_FALSE(buffer.full());
+    buffer.push_back(1);
+    buffer.push_back(2);
+    EXPECT_FALSE(buffer.full());
+    buffer.push_back(3);
+    EXPECT_TRUE(buffer.full());
+
+    // Overwriting keeps the buffer full
+    buffer.push_back(4);
+    EXPECT_TRUE(buffer.full());
+
+    buffer.pop_front();
+    EXPECT_FALSE(buffer.full());
+}
+
+TEST(CircularBufferTest, IteratorArithmeticAcrossWrap)
+{
+    CircularBuffer<int, 5> buffer;
+
+    // Place the oldest element near the end of the storage
+    for (int i = 1; i <= 8; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    auto it = buffer.end();
+    it -= 5;
+    EXPECT_EQ(*it, 4);
+    it += 4;
+    EXPECT_EQ(*it, 8);
+    --it;
+    EXPECT_EQ(*it, 7);
+    EXPECT_EQ(buffer.end() - buffer.begin(), 5);
+
+    auto rit = buffer.rbegin();
+    rit += 4;
+    EXPECT_EQ(*rit, 4);
+    rit -= 3;
+    EXPECT_EQ(*rit, 7);
+}
+
+namespace
+{
+    // Counts live instances and has no default constructor
+    struct Tracked
+    {
+        static int live;
+        int value;
+
+        explicit Tracked(int v) : value(v) { ++live; }
+        Tracked(const Tracked &other) : value(other.value) { ++live; }
+        Tracked(Tracked &&other) noexcept : value(other.value) { ++live; }
+        Tracked &operator=(const Tracked &) = default;
+        Tracked &operator=(Tracked &&) = default;
+        ~Tracked() { --live; }
+    };
+
+    int Tracked::live = 0;
+}
+
+TEST(CircularBufferTest, ElementsAreConstructedOnDemand)
+{
+    Tracked::live = 0;
+    {
+        CircularBuffer<Tracked, 3> buffer;
+        // No slot is constructed up front
+        EXPECT_EQ(Tracked::live, 0);
+
+        buffer.emplace_back(1);
+        buffer.push_back(Tracked(2));
+        EXPECT_EQ(Tracked::live, 2);
+
+        buffer.emplace_back(3);
+        buffer.emplace_back(4); // Overwrites the oldest element
+        EXPECT_EQ(Tracked::live, 3);
+        EXPECT_EQ(buffer.front().value, 2);
+
+        buffer.pop_front();
+        EXPECT_EQ(Tracked::live, 2);
+
+        buffer.clear();
+        EXPECT_EQ(Tracked::live, 0);
+
+        buffer.emplace_back(5);
+    }
+    // The destructor destroys the remaining elements
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(CircularBufferTest, EmplaceBackReturnsElement)
+{
+    CircularBuffer<std::pair<int, std::string>, 2> buffer;
+
+    auto &first = buffer.emplace_back(1, "one");
+    EXPECT_EQ(first.first, 1);
+    EXPECT_EQ(first.second, "one");
+
+    buffer.emplace_back(2, "two");
+    auto &third = buffer.emplace_back(3, "three");
+    EXPECT_EQ(third.second, "three");
+    EXPECT_EQ(buffer.front().second, "two");
+}
+
+TEST(CircularBufferTest, MovePushAndPop)
+{
+    CircularBuffer<std::unique_ptr<int>, 2> buffer;
+
+    buffer.push_back(std::make_unique<int>(1));
+    buffer.push_back(std::make_unique<int>(2));
+    buffer.push_back(std::make_unique<int>(3));
+
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(buffer.pop_front(value));
+    EXPECT_EQ(*value, 2);
+    EXPECT_TRUE(buffer.pop_front(value));
+    EXPECT_EQ(*value, 3);
+
+    // Popping from an empty buffer leaves the target untouched
+    EXPECT_FALSE(buffer.pop_front(value));
+    EXPECT_EQ(*value, 3);
+}
+
+TEST(CircularBufferTest, PopFrontReleasesElement)
+{
+    auto payload = std::make_shared<int>(0);
+    CircularBuffer<std::shared_ptr<int>, 4> buffer;
+
+    buffer.push_back(payload);
+    EXPECT_EQ(payload.use_count(), 2);
+
+    buffer.pop_front();
+    EXPECT_EQ(payload.use_count(), 1);
+}
+
+TEST(CircularBufferTest, CopyAndMoveNonTrivialElements)
+{
+    CircularBuffer<std::string, 3> buffer;
+    buffer.push_back("a");
+    buffer.push_back("b");
+    buffer.push_back("c");
+    buffer.push_back("d");
+
+    CircularBuffer<std::string, 3> copy(buffer);
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy[0], "b");
+    EXPECT_EQ(copy[2], "d");
+
+    CircularBuffer<std::string, 3> moved(std::move(buffer));
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved[0], "b");
+    EXPECT_TRUE(buffer.empty());
+
+    copy = moved;
+    copy.push_back("e");
+    EXPECT_EQ(moved[0], "b");
+    EXPECT_EQ(copy[0], "c");
+
+    buffer = std::move(copy);
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer.back(), "e");
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST(CircularBufferTest, BulkPushBack)
+{
+    CircularBuffer<int, 5> buffer;
+    std::vector<int> input = {1, 2, 3};
+
+    buffer.push_back(input.begin(), input.end());
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[2], 3);
+
+    // Wraps around and overwrites the oldest elements like push_back does
+    int more[] = {4, 5, 6, 7};
+    buffer.push_back(Span<const int>(more));
+    EXPECT_EQ(buffer.size(), 5);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        EXPECT_EQ(buffer[i], static_cast<int>(i) + 3);
+    }
+
+    // A range longer than the capacity keeps only its last elements
+    std::vector<int> large(12);
+    for (int i = 0; i < 12; ++i)
+    {
+        large[i] = 100 + i;
+    }
+    buffer.push_back(large);
+    EXPECT_EQ(buffer.size(), 5);
+    EXPECT_EQ(buffer.front(), 107);
+    EXPECT_EQ(buffer.back(), 111);
+}
+
+TEST(CircularBufferTest, BulkPushBackMatchesSinglePushes)
+{
+    CircularBuffer<std::string, 4> bulk;
+    CircularBuffer<std::string, 4> single;
+
+    std::list<std::string> input = {"a", "b", "c"};
+    for (int round = 0; round < 5; ++round)
+    {
+        bulk.push_back(input.begin(), input.end());
+        for (const auto &item : input)
+        {
+            single.push_back(item);
+        }
+        bulk.pop_front();
+        single.pop_front();
+
+        ASSERT_EQ(bulk.size(), single.size());
+        for (std::size_t i = 0; i < bulk.size(); ++i)
+        {
+            ASSERT_EQ(bulk[i], single[i]);
+        }
+    }
+}
+
+TEST(CircularBufferTest, BulkPushBackFromInputIterator)
+{
+    CircularBuffer<int, 3> buffer;
+    std::istringstream stream("1 2 3 4");
+
+    buffer.push_back(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer.front(), 2);
+    EXPECT_EQ(buffer.back(), 4);
+}
+
+TEST(CircularBufferTest, PopFrontN)
+{
+    CircularBuffer<std::string, 4> buffer;
+    buffer.push_back("a");
+    buffer.push_back("b");
+    buffer.push_back("c");
+
+    EXPECT_EQ(buffer.pop_front_n(2), 2);
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.front(), "c");
+
+    // Only the available elements are removed
+    EXPECT_EQ(buffer.pop_front_n(5), 1);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(CircularBufferTest, CopyOut)
+{
+    CircularBuffer<float, 4> buffer;
+    for (int i = 0; i < 6; ++i)
+    {
+        buffer.push_back(static_cast<float>(i));
+    }
+
+    // The contents wrap around the end of the storage
+    float out[6] = {};
+    EXPECT_EQ(buffer.copy_out(out, 6), 4);
+    EXPECT_EQ(out[0], 2.0f);
+    EXPECT_EQ(out[1], 3.0f);
+    EXPECT_EQ(out[2], 4.0f);
+    EXPECT_EQ(out[3], 5.0f);
+    EXPECT_EQ(buffer.size(), 4);
+
+    std::vector<float> partial;
+    EXPECT_EQ(buffer.copy_out(std::back_inserter(partial), 2), 2);
+    EXPECT_EQ(partial, (std::vector<float>{2.0f, 3.0f}));
+}
+
+TEST(CircularBufferTest, ArrayOneAndArrayTwo)
+{
+    CircularBuffer<int, 5> buffer;
+
+    EXPECT_TRUE(buffer.array_one().empty());
+    EXPECT_TRUE(buffer.array_two().empty());
+
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+
+    // Contiguous content lives entirely in the first segment
+    EXPECT_EQ(buffer.array_one().size(), 3);
+    EXPECT_TRUE(buffer.array_two().empty());
+    EXPECT_EQ(buffer.array_one()[0], 1);
+
+    for (int i = 4; i <= 7; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    // Content is now 3 4 5 | 6 7
+    const CircularBuffer<int, 5> &constBuffer = buffer;
+    Span<const int> one = constBuffer.array_one();
+    Span<const int> two = constBuffer.array_two();
+    EXPECT_EQ(one.size() + two.size(), 5);
+    std::vector<int> joined(one.begin(), one.end());
+    joined.insert(joined.end(), two.begin(), two.end());
+    EXPECT_EQ(joined, (std::vector<int>{3, 4, 5, 6, 7}));
+
+    // The views alias the storage
+    buffer.array_one()[0] = 30;
+    EXPECT_EQ(buffer.front(), 30);
+}
+
+TEST(CircularBufferTest, FreeSpaceAndCommit)
+{
+    CircularBuffer<int, 5> buffer;
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+    buffer.pop_front();
+    buffer.pop_front();
+
+    // One element at slot 2, free slots 3 4 | 0 1
+    Span<int> one = buffer.free_array_one();
+    Span<int> two = buffer.free_array_two();
+    EXPECT_EQ(one.size(), 2);
+    EXPECT_EQ(two.size(), 2);
+
+    one[0] = 4;
+    one[1] = 5;
+    two[0] = 6;
+    buffer.commit(3);
+
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_EQ(buffer[0], 3);
+    EXPECT_EQ(buffer[1], 4);
+    EXPECT_EQ(buffer[2], 5);
+    EXPECT_EQ(buffer[3], 6);
+
+    buffer.push_back(7);
+    EXPECT_TRUE(buffer.free_array_one().empty());
+    EXPECT_TRUE(buffer.free_array_two().empty());
+}
+
+TEST(CircularBufferTest, PopBack)
+{
+    CircularBuffer<int, 3> buffer;
+
+    // Popping from an empty buffer does nothing
+    buffer.pop_back();
+    EXPECT_TRUE(buffer.empty());
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    buffer.pop_back();
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer.back(), 3);
+    EXPECT_EQ(buffer.front(), 2);
+
+    buffer.push_back(5);
+    buffer.push_back(6);
+    EXPECT_EQ(buffer[0], 3);
+    EXPECT_EQ(buffer[2], 6);
+}
+
+TEST(CircularBufferTest, ReserveCommitPeekConsume)
+{
+    CircularBuffer<int, 5> buffer;
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+    buffer.pop_front();
+
+    // Elements at slots 1 2, reserved slots 3 4 | 0
+    Segments<int> slots = buffer.reserve(3);
+    EXPECT_EQ(slots.one.size(), 2);
+    EXPECT_EQ(slots.two.size(), 1);
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        slots[i] = 10 + static_cast<int>(i);
+    }
+    EXPECT_EQ(buffer.size(), 2);
+    buffer.commit(3);
+    EXPECT_EQ(buffer.size(), 5);
+
+    // Reserving more than is free evicts the oldest elements
+    slots = buffer.reserve(2);
+    EXPECT_EQ(buffer.size(), 3);
+    slots[0] = 20;
+    slots[1] = 21;
+    buffer.commit(2);
+
+    Segments<const int> view = static_cast<const CircularBuffer<int, 5> &>(buffer).peek(10);
+    ASSERT_EQ(view.size(), 5);
+    EXPECT_EQ(view[0], 10);
+    EXPECT_EQ(view[2], 12);
+    EXPECT_EQ(view[4], 21);
+
+    EXPECT_EQ(buffer.peek(2).size(), 2);
+    EXPECT_EQ(buffer.consume(2), 2);
+    EXPECT_EQ(buffer.front(), 12);
+    EXPECT_EQ(buffer.consume(10), 3);
+    EXPECT_TRUE(buffer.peek(1).empty());
+}
+
+TEST(CircularBufferTest, OverflowPolicies)
+{
+    CircularBuffer<int, 2> overwrite;
+    EXPECT_EQ(overwrite.try_push_back(1), PushStatus::Pushed);
+    EXPECT_EQ(overwrite.try_push_back(2), PushStatus::Pushed);
+    EXPECT_EQ(overwrite.try_push_back(3), PushStatus::Overwritten);
+    EXPECT_EQ(overwrite.try_emplace_back(4), PushStatus::Overwritten);
+    EXPECT_EQ(overwrite.front(), 3);
+
+    CircularBuffer<int, 2, OverflowPolicy::RejectNew> reject;
+    EXPECT_EQ(reject.try_push_back(1), PushStatus::Pushed);
+    EXPECT_EQ(reject.try_emplace_back(2), PushStatus::Pushed);
+    EXPECT_EQ(reject.try_push_back(3), PushStatus::Rejected);
+    EXPECT_FALSE(stored(reject.try_emplace_back(3)));
+    reject.push_back(4);
+    EXPECT_EQ(reject.front(), 1);
+    EXPECT_EQ(reject.back(), 2);
+
+    CircularBuffer<int, 2, OverflowPolicy::DropNewest> drop;
+    drop.push_back(1);
+    drop.push_back(2);
+    EXPECT_EQ(drop.try_push_back(3), PushStatus::Dropped);
+    EXPECT_EQ(drop.back(), 2);
+    drop.pop_front();
+    EXPECT_TRUE(stored(drop.try_push_back(3)));
+    EXPECT_EQ(drop.back(), 3);
+}
+
+TEST(CircularBufferTest, BulkOperationsFollowOverflowPolicy)
+{
+    int input[] = {1, 2, 3, 4, 5, 6};
+
+    CircularBuffer<int, 4> overwrite;
+    EXPECT_EQ(overwrite.push_back(std::begin(input), std::end(input)), 4);
+    EXPECT_EQ(overwrite.front(), 3);
+
+    CircularBuffer<int, 4, OverflowPolicy::RejectNew> reject;
+    reject.push_back(0);
+    // Only what fits is stored, the caller keeps the rest
+    EXPECT_EQ(reject.push_back(std::begin(input), std::end(input)), 3);
+    EXPECT_EQ(reject.front(), 0);
+    EXPECT_EQ(reject.back(), 3);
+    EXPECT_EQ(reject.push_back(Span<const int>(input)), 0);
+
+    CircularBuffer<int, 4, OverflowPolicy::DropNewest> drop;
+    std::istringstream stream("7 8 9 10 11");
+    EXPECT_EQ(drop.push_back(std::istream_iterator<int>(stream), std::istream_iterator<int>()), 4);
+    EXPECT_EQ(drop.back(), 10);
+
+    // Reserving never evicts without OverwriteOldest
+    drop.pop_front();
+    EXPECT_EQ(drop.reserve(3).size(), 1);
+    EXPECT_EQ(drop.front(), 8);
+}
+
+TEST(CircularBufferTest, Statistics)
+{
+    // Disabled statistics take no space
+    EXPECT_EQ(sizeof(CircularBuffer<int, 8>), sizeof(CircularBuffer<int, 8, OverflowPolicy::OverwriteOldest, true>) -
+                                                  sizeof(BufferStatistics) - sizeof(std::int64_t));
+
+    CircularBuffer<int, 3, OverflowPolicy::OverwriteOldest, true> buffer;
+    for (int i = 0; i < 5; ++i)
+    {
+        buffer.push_back(i);
+    }
+    buffer.pop_front();
+    int item = 0;
+    buffer.pop_front(item);
+    int input[] = {7, 8, 9, 10};
+    buffer.push_back(std::begin(input), std::end(input));
+
+    BufferStatistics statistics = buffer.statistics();
+    EXPECT_EQ(statistics.pushes, 9u);
+    EXPECT_EQ(statistics.pops, 2u);
+    // 2 of the single pushes and 2 of the bulk push replaced an element
+    EXPECT_EQ(statistics.overwrites, 4u);
+    EXPECT_EQ(statistics.rejections, 0u);
+    EXPECT_EQ(statistics.high_water_mark, 3u);
+    EXPECT_GT(statistics.time_full.count(), 0);
+
+    buffer.reset_statistics();
+    buffer.pop_front_n(2);
+    EXPECT_EQ(buffer.statistics().pops, 2u);
+    EXPECT_EQ(buffer.statistics().time_full.count(), 0);
+
+    CircularBuffer<int, 2, OverflowPolicy::RejectNew, true> reject;
+    reject.push_back(1);
+    reject.push_back(2);
+    reject.push_back(3);
+    EXPECT_EQ(reject.push_back(std::begin(input), std::end(input)), 0);
+    EXPECT_EQ(reject.statistics().pushes, 2u);
+    EXPECT_EQ(reject.statistics().rejections, 5u);
+    EXPECT_EQ(reject.statistics().overwrites, 0u);
+
+    // Input ranges count one rejection per refused element too, and are read
+    // to the end
+    reject.pop_front();
+    std::istringstream stream("4 5 6 7");
+    EXPECT_EQ(reject.push_back(std::istream_iterator<int>(stream), std::istream_iterator<int>()), 1);
+    EXPECT_EQ(reject.statistics().pushes, 3u);
+    EXPECT_EQ(reject.statistics().rejections, 8u);
+    EXPECT_TRUE(stream.eof());
+    EXPECT_EQ(reject.back(), 4);
+}
+
+#if CXXCIRCULARBUFFER_CONSTEXPR_STORAGE
+namespace
+{
+    // Squares of 1..6 pushed through a four-slot ring, leaving 9..36 wrapped
+    constexpr CircularBuffer<int, 4> make_squares()
+    {
+        CircularBuffer<int, 4> buffer;
+        for (int i = 1; i <= 6; ++i)
+        {
+            buffer.push_back(i * i);
+        }
+        return buffer;
+    }
+
+    constexpr int sum_of(const CircularBuffer<int, 4> &buffer)
+    {
+        int total = 0;
+        for (int value : buffer)
+        {
+            total += value;
+        }
+        return total;
+    }
+
+    constexpr CircularBuffer<int, 4> squares = make_squares();
+}
+
+TEST(CircularBufferTest, ConstantExpressions)
+{
+    static_assert(std::is_trivially_destructible<CircularBuffer<int, 4>>::value, "trivial buffer");
+    static_assert(squares.full() && squares.front() == 9 && squares.back() == 36, "precomputed ring");
+    static_assert(squares[1] == 16 && *(squares.rbegin() + 1) == 25, "random access");
+    static_assert(sum_of(squares) == 9 + 16 + 25 + 36, "iteration across the wrap");
+    static_assert(squares.array_two().size() == 2, "segments");
+
+    constexpr CircularBuffer<int, 4> drained = []() {
+        CircularBuffer<int, 4> buffer = make_squares();
+        int oldest = 0;
+        buffer.pop_front(oldest);
+        buffer.pop_back();
+        buffer.push_back(oldest);
+        buffer.pop_front_n(1);
+        return buffer;
+    }();
+    static_assert(drained.size() == 2 && drained.front() == 25 && drained.back() == 9, "pop and push");
+
+    // The same operations still run at run time
+    CircularBuffer<int, 4> runtime = squares;
+    runtime.push_back(49);
+    EXPECT_EQ(runtime.front(), 16);
+    EXPECT_EQ(sum_of(runtime), 16 + 25 + 36 + 49);
+}
+#endif
+
+TEST(CircularBufferTest, RunTimeConstructionLeavesSlotsUntouched)
+{
+    typedef CircularBuffer<std::uint32_t, 4> Buffer;
+    alignas(Buffer) unsigned char raw[sizeof(Buffer)];
+    // Volatile accesses, so the pattern is neither dropped as a dead store
+    // before the constructor nor assumed away when read back
+    volatile unsigned char *bytes = raw;
+    for (std::size_t i = 0; i != sizeof(raw); ++i)
+    {
+        bytes[i] = 0xA5;
+    }
+
+    Buffer *buffer = ::new (static_cast<void *>(raw)) Buffer;
+    buffer->push_back(7);
+    EXPECT_EQ(buffer->front(), 7u);
+
+    const Segments<std::uint32_t> free = buffer->reserve(3);
+    EXPECT_EQ(free.size(), 3);
+    const volatile unsigned char *slots = reinterpret_cast<unsigned char *>(free.one.data());
+    for (std::size_t i = 0; i != free.size() * sizeof(std::uint32_t); ++i)
+    {
+        const unsigned int byte = slots[i];
+        EXPECT_EQ(byte, 0xA5u) << "byte " << i;
+    }
+    buffer->~Buffer();
+}
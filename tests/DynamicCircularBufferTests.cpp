@@ -0,0 +1,396 @@
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <CXXCircularBuffer/DynamicCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // Allocator counting the live allocations of all its copies
+    template <typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        std::shared_ptr<int> allocations;
+
+        CountingAllocator() : allocations(std::make_shared<int>(0)) {}
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U> &other) : allocations(other.allocations) {}
+
+        T *allocate(std::size_t n)
+        {
+            ++*allocations;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n)
+        {
+            --*allocations;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const CountingAllocator &other) const { return allocations == other.allocations; }
+        bool operator!=(const CountingAllocator &other) const { return !(*this == other); }
+    };
+
+    template <typename Buffer>
+    std::vector<typename Buffer::value_type> contents(const Buffer &buffer)
+    {
+        return std::vector<typename Buffer::value_type>(buffer.begin(), buffer.end());
+    }
+
+    // Runs the same sequence on any buffer of capacity 3, returning what it
+    // observed, so that both buffer types can be compared
+    template <typename Buffer>
+    std::vector<int> interchangeable_sequence(Buffer &buffer)
+    {
+        std::vector<int> observed;
+        for (int i = 1; i <= 4; ++i)
+        {
+            observed.push_back(static_cast<int>(buffer.try_push_back(i)));
+        }
+        observed.push_back(static_cast<int>(buffer.try_emplace_back(5)));
+        buffer.pop_back();
+        int item = 0;
+        observed.push_back(buffer.pop_front(item));
+        observed.push_back(item);
+        int input[] = {6, 7, 8};
+        observed.push_back(static_cast<int>(buffer.push_back(std::begin(input), std::end(input))));
+        for (typename Buffer::CircularBufferIterator it = buffer.begin(); it != buffer.end(); ++it)
+        {
+            observed.push_back(*it);
+        }
+        const BufferStatistics statistics = buffer.statistics();
+        observed.push_back(static_cast<int>(statistics.pushes));
+        observed.push_back(static_cast<int>(statistics.pops));
+        observed.push_back(static_cast<int>(statistics.overwrites));
+        observed.push_back(static_cast<int>(statistics.rejections));
+        return observed;
+    }
+}
+
+TEST(DynamicCircularBufferTest, PushBackAndPopFront)
+{
+    DynamicCircularBuffer<int> buffer(3);
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), 3);
+
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+    EXPECT_TRUE(buffer.full());
+
+    // Pushing into a full buffer overwrites the oldest element
+    buffer.push_back(4);
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(buffer[0], 2);
+    EXPECT_EQ(buffer.back(), 4);
+
+    buffer.pop_front();
+    EXPECT_EQ(buffer.front(), 3);
+
+    int value = 0;
+    EXPECT_TRUE(buffer.pop_front(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST(DynamicCircularBufferTest, PopBackAcrossTheWrap)
+{
+    DynamicCircularBuffer<std::string> buffer(3);
+    for (const char *item : {"a", "b", "c", "d"})
+    {
+        buffer.push_back(item);
+    }
+
+    // The newest element sits in the first slot, behind the wrap
+    buffer.pop_back();
+    EXPECT_EQ(contents(buffer), (std::vector<std::string>{"b", "c"}));
+    buffer.pop_back();
+    buffer.pop_back();
+    EXPECT_TRUE(buffer.empty());
+    buffer.pop_back();
+    EXPECT_TRUE(buffer.empty());
+
+    buffer.push_back("e");
+    EXPECT_EQ(buffer.front(), "e");
+}
+
+TEST(DynamicCircularBufferTest, OverflowPolicies)
+{
+    typedef std::allocator<int> Allocator;
+    DynamicCircularBuffer<int> overwrite(2);
+    EXPECT_EQ(overwrite.try_push_back(1), PushStatus::Pushed);
+    EXPECT_EQ(overwrite.try_emplace_back(2), PushStatus::Pushed);
+    EXPECT_EQ(overwrite.try_push_back(3), PushStatus::Overwritten);
+    EXPECT_EQ(overwrite.front(), 2);
+
+    DynamicCircularBuffer<int, Allocator, OverflowPolicy::RejectNew> reject(2);
+    EXPECT_EQ(reject.try_push_back(1), PushStatus::Pushed);
+    EXPECT_EQ(reject.try_emplace_back(2), PushStatus::Pushed);
+    EXPECT_EQ(reject.try_push_back(3), PushStatus::Rejected);
+    EXPECT_EQ(reject.try_emplace_back(3), PushStatus::Rejected);
+    EXPECT_EQ(reject.back(), 2);
+
+    // Only what fits is stored, whatever the kind of range
+    int input[] = {4, 5, 6};
+    reject.pop_front();
+    EXPECT_EQ(reject.push_back(std::begin(input), std::end(input)), 1);
+    EXPECT_EQ(reject.back(), 4);
+    EXPECT_EQ(reject.reserve(2).size(), 0);
+
+    DynamicCircularBuffer<int, Allocator, OverflowPolicy::DropNewest> drop(3);
+    std::istringstream stream("7 8 9 10 11");
+    EXPECT_EQ(drop.push_back(std::istream_iterator<int>(stream), std::istream_iterator<int>()), 3);
+    EXPECT_EQ(drop.try_push_back(12), PushStatus::Dropped);
+    EXPECT_EQ(drop.front(), 7);
+    EXPECT_EQ(drop.back(), 9);
+
+    DynamicCircularBuffer<int, Allocator, OverflowPolicy::RejectNew> none;
+    EXPECT_EQ(none.try_push_back(1), PushStatus::Rejected);
+    EXPECT_EQ(none.try_emplace_back(1), PushStatus::Rejected);
+}
+
+TEST(DynamicCircularBufferTest, Statistics)
+{
+    typedef std::allocator<int> Allocator;
+    DynamicCircularBuffer<int, Allocator, OverflowPolicy::OverwriteOldest, true> buffer(3);
+    for (int i = 0; i < 5; ++i)
+    {
+        buffer.push_back(i);
+    }
+    buffer.pop_front();
+    int item = 0;
+    buffer.pop_front(item);
+    int input[] = {7, 8, 9, 10};
+    buffer.push_back(std::begin(input), std::end(input));
+
+    // The same operations as on CircularBuffer give the same counts
+    BufferStatistics statistics = buffer.statistics();
+    EXPECT_EQ(statistics.pushes, 9u);
+    EXPECT_EQ(statistics.pops, 2u);
+    EXPECT_EQ(statistics.overwrites, 4u);
+    EXPECT_EQ(statistics.rejections, 0u);
+    EXPECT_EQ(statistics.high_water_mark, 3u);
+    EXPECT_GT(statistics.time_full.count(), 0);
+
+    buffer.reset_statistics();
+    buffer.pop_back();
+    buffer.pop_front_n(2);
+    EXPECT_EQ(buffer.statistics().pops, 3u);
+    EXPECT_EQ(buffer.statistics().time_full.count(), 0);
+
+    // Growing a full buffer ends its full period
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+    buffer.set_capacity(4);
+    const BufferStatistics grown = buffer.statistics();
+    EXPECT_GT(grown.time_full.count(), 0);
+    EXPECT_EQ(buffer.statistics().time_full, grown.time_full);
+
+    DynamicCircularBuffer<int, Allocator, OverflowPolicy::RejectNew, true> reject(2);
+    reject.push_back(1);
+    reject.push_back(2);
+    reject.push_back(3);
+    EXPECT_EQ(reject.try_emplace_back(4), PushStatus::Rejected);
+    EXPECT_EQ(reject.push_back(std::begin(input), std::end(input)), 0);
+    EXPECT_EQ(reject.statistics().pushes, 2u);
+    EXPECT_EQ(reject.statistics().rejections, 6u);
+    EXPECT_EQ(reject.statistics().overwrites, 0u);
+}
+
+TEST(DynamicCircularBufferTest, IteratorsMatchFixedBuffer)
+{
+    DynamicCircularBuffer<int> buffer(5);
+    for (int i = 1; i <= 8; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    EXPECT_EQ(contents(buffer), (std::vector<int>{4, 5, 6, 7, 8}));
+
+    int expected = 8;
+    for (auto rit = buffer.rbegin(); rit != buffer.rend(); ++rit, --expected)
+    {
+        EXPECT_EQ(*rit, expected);
+    }
+
+    auto it = buffer.begin();
+    it += 3;
+    EXPECT_EQ(*it, 7);
+    EXPECT_EQ(buffer.end() - buffer.begin(), 5);
+}
+
+TEST(DynamicCircularBufferTest, InterchangeableWithCircularBuffer)
+{
+    CircularBuffer<int, 3, OverflowPolicy::OverwriteOldest, true> fixed;
+    DynamicCircularBuffer<int, std::allocator<int>, OverflowPolicy::OverwriteOldest, true> dynamic(3);
+    EXPECT_EQ(interchangeable_sequence(dynamic), interchangeable_sequence(fixed));
+
+    CircularBuffer<int, 3, OverflowPolicy::RejectNew, true> fixed_reject;
+    DynamicCircularBuffer<int, std::allocator<int>, OverflowPolicy::RejectNew, true> dynamic_reject(3);
+    EXPECT_EQ(interchangeable_sequence(dynamic_reject), interchangeable_sequence(fixed_reject));
+}
+
+TEST(DynamicCircularBufferTest, SetCapacityGrowsAndLinearizes)
+{
+    DynamicCircularBuffer<std::string> buffer(3);
+    buffer.push_back("a");
+    buffer.push_back("b");
+    buffer.push_back("c");
+    buffer.push_back("d");
+
+    buffer.set_capacity(5);
+    EXPECT_EQ(buffer.capacity(), 5);
+    EXPECT_EQ(contents(buffer), (std::vector<std::string>{"b", "c", "d"}));
+
+    // The content is contiguous after relinearizing
+    EXPECT_EQ(buffer.array_one().size(), 3);
+    EXPECT_TRUE(buffer.array_two().empty());
+
+    buffer.push_back("e");
+    buffer.push_back("f");
+    buffer.push_back("g");
+    EXPECT_EQ(contents(buffer), (std::vector<std::string>{"c", "d", "e", "f", "g"}));
+}
+
+TEST(DynamicCircularBufferTest, SetCapacityShrinksKeepingNewest)
+{
+    DynamicCircularBuffer<int> buffer(5);
+    for (int i = 1; i <= 7; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    buffer.set_capacity(2);
+    EXPECT_EQ(buffer.capacity(), 2);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{6, 7}));
+
+    buffer.set_capacity(0);
+    EXPECT_TRUE(buffer.empty());
+    buffer.push_back(1);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_THROW(buffer.emplace_back(1), std::length_error);
+
+    const std::vector<int> input = {1, 2};
+    EXPECT_EQ(buffer.push_back(input.begin(), input.end()), 0);
+    EXPECT_TRUE(buffer.empty());
+
+    DynamicCircularBuffer<int> unallocated;
+    EXPECT_THROW(unallocated.emplace_back(1), std::length_error);
+    EXPECT_EQ(unallocated.push_back(input), 0);
+    EXPECT_TRUE(unallocated.empty());
+}
+
+TEST(DynamicCircularBufferTest, Resize)
+{
+    DynamicCircularBuffer<int> buffer(2);
+    buffer.push_back(1);
+
+    buffer.resize(4, 9);
+    EXPECT_EQ(buffer.capacity(), 4);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{1, 9, 9, 9}));
+
+    buffer.resize(2);
+    EXPECT_EQ(buffer.capacity(), 4);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{1, 9}));
+}
+
+TEST(DynamicCircularBufferTest, BulkOperations)
+{
+    DynamicCircularBuffer<int> buffer(4);
+    std::vector<int> input = {1, 2, 3, 4, 5, 6};
+
+    EXPECT_EQ(buffer.push_back(input), 4);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{3, 4, 5, 6}));
+
+    EXPECT_EQ(buffer.pop_front_n(3), 3);
+    EXPECT_EQ(buffer.push_back(input.begin(), input.begin() + 2), 2);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{6, 1, 2}));
+
+    int out[4] = {};
+    EXPECT_EQ(buffer.copy_out(out, 4), 3);
+    EXPECT_EQ(out[0], 6);
+    EXPECT_EQ(out[2], 2);
+
+    // Single-pass ranges report the same count
+    std::istringstream stream("7 8 9 10 11");
+    EXPECT_EQ(buffer.push_back(std::istream_iterator<int>(stream), std::istream_iterator<int>()), 4);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{8, 9, 10, 11}));
+}
+
+TEST(DynamicCircularBufferTest, ReserveCommitPeekConsume)
+{
+    DynamicCircularBuffer<int> buffer(4);
+    buffer.push_back(1);
+    buffer.push_back(2);
+    buffer.push_back(3);
+
+    // One free slot, so reserving two evicts 1
+    Segments<int> slots = buffer.reserve(2);
+    EXPECT_EQ(slots.one.size(), 1);
+    EXPECT_EQ(slots.two.size(), 1);
+    slots[0] = 4;
+    slots[1] = 5;
+    buffer.commit(2);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{2, 3, 4, 5}));
+
+    Segments<int> view = buffer.peek(3);
+    EXPECT_EQ(view[0], 2);
+    EXPECT_EQ(view[2], 4);
+    EXPECT_EQ(buffer.consume(3), 3);
+    EXPECT_EQ(contents(buffer), (std::vector<int>{5}));
+
+    DynamicCircularBuffer<int> empty(0);
+    EXPECT_TRUE(empty.reserve(3).empty());
+}
+
+TEST(DynamicCircularBufferTest, UsesAllocator)
+{
+    CountingAllocator<std::string> allocator;
+    {
+        DynamicCircularBuffer<std::string, CountingAllocator<std::string>> buffer(4, allocator);
+        EXPECT_EQ(*allocator.allocations, 1);
+
+        buffer.push_back("x");
+        buffer.set_capacity(8);
+        EXPECT_EQ(*allocator.allocations, 1);
+        EXPECT_EQ(buffer.front(), "x");
+
+        auto copy = buffer;
+        EXPECT_EQ(*allocator.allocations, 2);
+
+        auto moved = std::move(copy);
+        EXPECT_EQ(*allocator.allocations, 2);
+        EXPECT_EQ(moved.front(), "x");
+    }
+    EXPECT_EQ(*allocator.allocations, 0);
+}
+
+TEST(DynamicCircularBufferTest, CopyAndMoveAssignment)
+{
+    DynamicCircularBuffer<std::string> buffer(3);
+    buffer.push_back("a");
+    buffer.push_back("b");
+
+    DynamicCircularBuffer<std::string> copy(1);
+    copy = buffer;
+    EXPECT_EQ(copy.capacity(), 3);
+    EXPECT_EQ(contents(copy), (std::vector<std::string>{"a", "b"}));
+
+    DynamicCircularBuffer<std::string> moved;
+    moved = std::move(buffer);
+    EXPECT_EQ(contents(moved), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(buffer.capacity(), 0);
+}
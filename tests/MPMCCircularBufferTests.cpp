@@ -0,0 +1,284 @@
+#include <CXXCircularBuffer/MPMCCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+TEST(MPMCCircularBufferTest, EnqueueAndDequeue)
+{
+    MPMCCircularBuffer<int, 3> buffer;
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), 3);
+
+    EXPECT_TRUE(buffer.try_enqueue(1));
+    EXPECT_TRUE(buffer.try_enqueue(2));
+    EXPECT_TRUE(buffer.try_enqueue(3));
+    EXPECT_EQ(buffer.size(), 3);
+
+    // The buffer is full, enqueueing must fail instead of overwriting
+    EXPECT_FALSE(buffer.try_enqueue(4));
+
+    int value = 0;
+    for (int expected = 1; expected <= 3; ++expected)
+    {
+        EXPECT_TRUE(buffer.try_dequeue(value));
+        EXPECT_EQ(value, expected);
+    }
+
+    EXPECT_FALSE(buffer.try_dequeue(value));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MPMCCircularBufferTest, WrapAround)
+{
+    MPMCCircularBuffer<int, 4> buffer;
+
+    int value = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(buffer.try_enqueue(i));
+        EXPECT_TRUE(buffer.try_enqueue(i + 100));
+        EXPECT_TRUE(buffer.try_dequeue(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(buffer.try_dequeue(value));
+        EXPECT_EQ(value, i + 100);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MPMCCircularBufferTest, BulkOperations)
+{
+    MPMCCircularBuffer<int, 5> buffer;
+    std::vector<int> input = {1, 2, 3, 4, 5, 6, 7};
+
+    // Only as many elements as there are free slots are enqueued
+    EXPECT_EQ(buffer.try_enqueue_bulk(input.begin(), input.size()), 5);
+    EXPECT_EQ(buffer.try_enqueue_bulk(input.begin(), input.size()), 0);
+
+    std::vector<int> output(3);
+    EXPECT_EQ(buffer.try_dequeue_bulk(output.begin(), output.size()), 3);
+    EXPECT_EQ(output, (std::vector<int>{1, 2, 3}));
+
+    EXPECT_EQ(buffer.try_enqueue_bulk(input.begin() + 5, 2), 2);
+
+    output.assign(10, 0);
+    EXPECT_EQ(buffer.try_dequeue_bulk(output.begin(), output.size()), 4);
+    EXPECT_EQ(output[0], 4);
+    EXPECT_EQ(output[1], 5);
+    EXPECT_EQ(output[2], 6);
+    EXPECT_EQ(output[3], 7);
+
+    EXPECT_EQ(buffer.try_dequeue_bulk(output.begin(), output.size()), 0);
+}
+
+TEST(MPMCCircularBufferTest, ConsumeInPlace)
+{
+    MPMCCircularBuffer<std::vector<int>, 4> buffer;
+    EXPECT_TRUE(buffer.try_emplace(3, 7));
+    EXPECT_TRUE(buffer.try_emplace(2, 8));
+
+    const int *seen = nullptr;
+    EXPECT_TRUE(buffer.try_consume([&seen](std::vector<int> &item)
+                                   {
+        EXPECT_EQ(item, (std::vector<int>{7, 7, 7}));
+        seen = item.data(); }));
+    EXPECT_NE(seen, nullptr);
+
+    // The slot is released even when the reader throws
+    EXPECT_THROW(buffer.try_consume([](std::vector<int> &)
+                                    { throw 1; }),
+                 int);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.try_consume([](std::vector<int> &) {}));
+}
+
+TEST(MPMCCircularBufferTest, Statistics)
+{
+    MPMCCircularBuffer<int, 4, true> buffer;
+    std::vector<int> input = {1, 2, 3, 4, 5, 6};
+    EXPECT_TRUE(buffer.try_enqueue(0));
+    EXPECT_EQ(buffer.try_enqueue_bulk(input.begin(), input.size()), 3);
+
+    int item = 0;
+    EXPECT_TRUE(buffer.try_dequeue(item));
+    std::vector<int> output(2);
+    EXPECT_EQ(buffer.try_dequeue_bulk(output.begin(), output.size()), 2);
+
+    BufferStatistics statistics = buffer.statistics();
+    EXPECT_EQ(statistics.pushes, 4u);
+    EXPECT_EQ(statistics.pops, 3u);
+    EXPECT_EQ(statistics.rejections, 3u);
+    EXPECT_EQ(statistics.overwrites, 0u);
+    EXPECT_EQ(statistics.high_water_mark, 4u);
+
+    buffer.reset_statistics();
+    EXPECT_EQ(buffer.statistics().pushes, 0u);
+}
+
+TEST(MPMCCircularBufferTest, DestroysRemainingElements)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        MPMCCircularBuffer<std::shared_ptr<int>, 4> buffer;
+        buffer.try_enqueue(counter);
+        buffer.try_enqueue(counter);
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+namespace
+{
+    // Construction from a negative value throws; moves never do
+    struct Checked
+    {
+        int value;
+
+        explicit Checked(int v) : value(v)
+        {
+            if (v < 0)
+            {
+                throw std::invalid_argument("negative");
+            }
+        }
+    };
+}
+
+TEST(MPMCCircularBufferTest, ThrowingConstructorLeavesNoClaimedSlot)
+{
+    MPMCCircularBuffer<Checked, 2> buffer;
+    EXPECT_THROW(buffer.try_emplace(-1), std::invalid_argument);
+    EXPECT_TRUE(buffer.empty());
+
+    // Consumers are not stalled on a slot that was never published
+    EXPECT_TRUE(buffer.try_emplace(1));
+    EXPECT_THROW(buffer.try_emplace(-2), std::invalid_argument);
+    EXPECT_TRUE(buffer.try_emplace(2));
+    EXPECT_FALSE(buffer.try_emplace(3));
+
+    Checked item(0);
+    ASSERT_TRUE(buffer.try_dequeue(item));
+    EXPECT_EQ(item.value, 1);
+    ASSERT_TRUE(buffer.try_dequeue(item));
+    EXPECT_EQ(item.value, 2);
+    EXPECT_FALSE(buffer.try_dequeue(item));
+}
+
+namespace
+{
+    // Moving a negative value out throws
+    struct Poisoned
+    {
+        int value = 0;
+
+        Poisoned() = default;
+        explicit Poisoned(int v) noexcept : value(v) {}
+        Poisoned(Poisoned &&other) noexcept = default;
+
+        Poisoned &operator=(Poisoned &&other)
+        {
+            if (other.value < 0)
+            {
+                throw std::runtime_error("poisoned");
+            }
+            value = other.value;
+            return *this;
+        }
+    };
+}
+
+TEST(MPMCCircularBufferTest, ThrowingAssignmentReleasesDequeuedSlots)
+{
+    MPMCCircularBuffer<Poisoned, 4> buffer;
+    ASSERT_TRUE(buffer.try_emplace(1));
+    ASSERT_TRUE(buffer.try_emplace(-1));
+    ASSERT_TRUE(buffer.try_emplace(2));
+
+    Poisoned item;
+    ASSERT_TRUE(buffer.try_dequeue(item));
+    EXPECT_EQ(item.value, 1);
+    EXPECT_THROW(buffer.try_dequeue(item), std::runtime_error);
+    ASSERT_TRUE(buffer.try_dequeue(item));
+    EXPECT_EQ(item.value, 2);
+    EXPECT_TRUE(buffer.empty());
+
+    // The bulk path drops the rest of its claim, and the ring keeps cycling
+    ASSERT_TRUE(buffer.try_emplace(3));
+    ASSERT_TRUE(buffer.try_emplace(-3));
+    ASSERT_TRUE(buffer.try_emplace(4));
+    std::vector<Poisoned> out(3);
+    EXPECT_THROW(buffer.try_dequeue_bulk(out.begin(), 3), std::runtime_error);
+    EXPECT_EQ(out[0].value, 3);
+    EXPECT_TRUE(buffer.empty());
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_TRUE(buffer.try_emplace(i));
+        }
+        EXPECT_EQ(buffer.try_dequeue_bulk(out.begin(), 3), 3);
+        ASSERT_TRUE(buffer.try_dequeue(item));
+        EXPECT_EQ(item.value, 3);
+    }
+}
+
+TEST(MPMCCircularBufferTest, MultipleProducersAndConsumers)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 20000;
+    MPMCCircularBuffer<long, 64> buffer;
+
+    std::atomic<long> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&buffer]()
+                             {
+            for (long i = 1; i <= per_producer; ++i)
+            {
+                while (!buffer.try_enqueue(i))
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&]()
+                             {
+            long value = 0;
+            while (consumed.load() < producers * per_producer)
+            {
+                if (buffer.try_dequeue(value))
+                {
+                    sum += value;
+                    ++consumed;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every element must be dequeued exactly once
+    const long expected = static_cast<long>(producers) * per_producer * (per_producer + 1) / 2;
+    EXPECT_EQ(consumed.load(), producers * per_producer);
+    EXPECT_EQ(sum.load(), expected);
+    EXPECT_TRUE(buffer.empty());
+}
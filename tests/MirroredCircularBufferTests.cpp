@@ -0,0 +1,123 @@
+#include <CXXCircularBuffer/MirroredCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace CXXCircularBuffer;
+
+TEST(MirroredCircularBufferTest, CapacityIsRoundedToPages)
+{
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    MirroredCircularBuffer<> bytes(100);
+    EXPECT_EQ(bytes.capacity(), page);
+    EXPECT_TRUE(bytes.empty());
+
+    MirroredCircularBuffer<std::uint32_t> words(page);
+    EXPECT_EQ(words.capacity() * sizeof(std::uint32_t) % page, 0);
+    EXPECT_GE(words.capacity(), page);
+}
+
+TEST(MirroredCircularBufferTest, RejectsCapacitiesThatCannotBeMappedTwice)
+{
+    const std::size_t max = std::numeric_limits<std::size_t>::max();
+    EXPECT_THROW((MirroredCircularBuffer<>(max)), std::length_error);
+    EXPECT_THROW((MirroredCircularBuffer<>(max / 2)), std::length_error);
+    EXPECT_THROW((MirroredCircularBuffer<std::uint64_t>(max / 8)), std::length_error);
+}
+
+TEST(MirroredCircularBufferTest, WriteAndConsume)
+{
+    MirroredCircularBuffer<> buffer(1);
+    const std::string message = "hello";
+
+    EXPECT_EQ(buffer.write(Span<const unsigned char>(
+                  reinterpret_cast<const unsigned char *>(message.data()), message.size())),
+              message.size());
+    EXPECT_EQ(buffer.size(), message.size());
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(buffer.data()), buffer.size()), message);
+
+    EXPECT_EQ(buffer.consume(2), 2);
+    EXPECT_EQ(buffer.front(), 'l');
+    EXPECT_EQ(buffer.back(), 'o');
+
+    // Consuming more than stored only removes what is there
+    EXPECT_EQ(buffer.consume(100), 3);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MirroredCircularBufferTest, ContentStaysContiguousAcrossWrap)
+{
+    MirroredCircularBuffer<int> buffer(1);
+    const std::size_t capacity = buffer.capacity();
+
+    // Move the start close to the end of the storage
+    std::vector<int> filler(capacity - 3, 0);
+    buffer.write(filler);
+    buffer.consume(filler.size());
+
+    std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(buffer.write(values), values.size());
+
+    // The elements straddle the wrap point but read back as one array
+    const int *data = buffer.data();
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(data[i], values[i]);
+        EXPECT_EQ(buffer[i], values[i]);
+    }
+    EXPECT_EQ(buffer.array().size(), values.size());
+}
+
+TEST(MirroredCircularBufferTest, FreeSpaceAndCommit)
+{
+    MirroredCircularBuffer<> buffer(1);
+    const std::size_t capacity = buffer.capacity();
+
+    std::vector<unsigned char> filler(capacity - 1, 'x');
+    buffer.write(filler);
+    buffer.consume(filler.size());
+
+    // The free space is contiguous even though it wraps
+    Span<unsigned char> space = buffer.free_array();
+    EXPECT_EQ(space.size(), capacity);
+    space[0] = 'a';
+    space[1] = 'b';
+    buffer.commit(2);
+
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer[0], 'a');
+    EXPECT_EQ(buffer[1], 'b');
+}
+
+TEST(MirroredCircularBufferTest, WriteStopsWhenFull)
+{
+    MirroredCircularBuffer<> buffer(1);
+    std::vector<unsigned char> data(buffer.capacity() + 10, 'z');
+
+    EXPECT_EQ(buffer.write(data), buffer.capacity());
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.write(data), 0);
+}
+
+TEST(MirroredCircularBufferTest, MoveTransfersMapping)
+{
+    MirroredCircularBuffer<> buffer(1);
+    const unsigned char byte = 42;
+    buffer.write(Span<const unsigned char>(&byte, 1));
+
+    MirroredCircularBuffer<> moved(std::move(buffer));
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(moved.front(), 42);
+    EXPECT_EQ(buffer.capacity(), 0);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,219 @@
+#include <CXXCircularBuffer/PersistentCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    struct Event
+    {
+        std::uint64_t id;
+        double value;
+    };
+
+    // Fresh file path for one test, removed again by the destructor
+    struct TemporaryFile
+    {
+        std::string path;
+
+        explicit TemporaryFile(const std::string &name)
+            : path(testing::TempDir() + "cxxcircularbuffer_" + name + "_" + std::to_string(::getpid()))
+        {
+            ::unlink(path.c_str());
+        }
+
+        ~TemporaryFile()
+        {
+            ::unlink(path.c_str());
+        }
+    };
+
+    template <typename Buffer>
+    std::vector<std::uint64_t> ids(const Buffer &buffer)
+    {
+        std::vector<std::uint64_t> result;
+        for (const Event &event : buffer)
+        {
+            result.push_back(event.id);
+        }
+        return result;
+    }
+}
+
+TEST(PersistentCircularBufferTest, ContentSurvivesReopening)
+{
+    TemporaryFile file("reopen");
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 4);
+        EXPECT_TRUE(buffer.empty());
+        for (std::uint64_t i = 1; i <= 6; ++i)
+        {
+            buffer.push_back(Event{i, i * 0.5});
+        }
+        buffer.pop_front();
+        buffer.sync();
+    }
+
+    PersistentCircularBuffer<Event> buffer(file.path, 4);
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_EQ(ids(buffer), (std::vector<std::uint64_t>{4, 5, 6}));
+    EXPECT_EQ(buffer.front().value, 2.0);
+    EXPECT_EQ(buffer.back().id, 6u);
+
+    // Keeps going from the recovered state, across the wrap
+    buffer.push_back(Event{7, 3.5});
+    buffer.push_back(Event{8, 4.0});
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer[0].id, 5u);
+    EXPECT_EQ(buffer.array_one().size() + buffer.array_two().size(), 4);
+    EXPECT_EQ(buffer.rbegin()->id, 8u);
+
+    Event event{};
+    EXPECT_TRUE(buffer.pop_front(event));
+    EXPECT_EQ(event.id, 5u);
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(PersistentCircularBufferTest, RecoversAfterProcessCrash)
+{
+    TemporaryFile file("crash");
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 8);
+        buffer.push_back(Event{1, 0});
+    }
+
+    const pid_t child = ::fork();
+    ASSERT_NE(child, -1);
+    if (child == 0)
+    {
+        // Neither sync() nor the destructor run before the process dies
+        PersistentCircularBuffer<Event> buffer(file.path, 8);
+        for (std::uint64_t i = 2; i <= 10; ++i)
+        {
+            buffer.push_back(Event{i, 0});
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+    PersistentCircularBuffer<Event> buffer(file.path, 8);
+    EXPECT_EQ(ids(buffer), (std::vector<std::uint64_t>{3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST(PersistentCircularBufferTest, RejectsMismatchedFile)
+{
+    TemporaryFile file("mismatch");
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 4);
+        buffer.push_back(Event{1, 0});
+    }
+
+    EXPECT_THROW((PersistentCircularBuffer<Event>(file.path, 5)), std::runtime_error);
+    EXPECT_THROW((PersistentCircularBuffer<std::uint32_t>(file.path, 4)), std::runtime_error);
+
+    // The file was left untouched
+    PersistentCircularBuffer<Event> buffer(file.path, 4);
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_THROW((PersistentCircularBuffer<Event>("/nonexistent/ring", 4)), std::system_error);
+}
+
+TEST(PersistentCircularBufferTest, UsesTheRecordedDataOffset)
+{
+    TemporaryFile file("offset");
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 4);
+        for (std::uint64_t i = 1; i <= 3; ++i)
+        {
+            buffer.push_back(Event{i, 0});
+        }
+    }
+    std::string bytes;
+    {
+        std::ifstream in(file.path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    // data_offset follows magic, version, element_size and capacity
+    const std::size_t data_offset_at = 24;
+    const auto rewrite = [&file](const std::string &content) {
+        std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+        out << content;
+    };
+
+    // A file created where pages are twice as large is read where it says
+    std::string moved = bytes.substr(0, page) + std::string(page, '\0') + bytes.substr(page);
+    const std::uint64_t offset = 2 * page;
+    moved.replace(data_offset_at, sizeof(offset), reinterpret_cast<const char *>(&offset), sizeof(offset));
+    rewrite(moved);
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 4);
+        EXPECT_EQ(ids(buffer), (std::vector<std::uint64_t>{1, 2, 3}));
+    }
+
+    // Anything but exactly the data after the offset is not this ring
+    rewrite(bytes + std::string(sizeof(Event), '\0'));
+    EXPECT_THROW((PersistentCircularBuffer<Event>(file.path, 4)), std::runtime_error);
+    std::string misplaced = bytes;
+    const std::uint64_t unaligned = page + 1;
+    misplaced.replace(data_offset_at, sizeof(unaligned), reinterpret_cast<const char *>(&unaligned),
+                      sizeof(unaligned));
+    rewrite(misplaced);
+    EXPECT_THROW((PersistentCircularBuffer<Event>(file.path, 4)), std::runtime_error);
+
+    rewrite(bytes);
+    PersistentCircularBuffer<Event> buffer(file.path, 4);
+    EXPECT_EQ(buffer.size(), 3);
+}
+
+TEST(PersistentCircularBufferTest, LeavesForeignFilesUntouched)
+{
+    // Zeroed files of another size, and short files, are not rings
+    for (std::size_t size : {std::size_t(4), std::size_t(4096), std::size_t(100000)})
+    {
+        TemporaryFile file("foreign");
+        {
+            std::ofstream out(file.path, std::ios::binary);
+            out << std::string(size, '\0');
+        }
+        EXPECT_THROW((PersistentCircularBuffer<Event>(file.path, 4)), std::runtime_error) << size;
+
+        struct stat status;
+        ASSERT_EQ(::stat(file.path.c_str(), &status), 0);
+        EXPECT_EQ(static_cast<std::size_t>(status.st_size), size);
+    }
+
+    // A zeroed file of exactly the ring's size is an interrupted creation
+    TemporaryFile file("interrupted");
+    std::size_t size;
+    {
+        PersistentCircularBuffer<Event> buffer(file.path, 4);
+        struct stat status;
+        ASSERT_EQ(::stat(file.path.c_str(), &status), 0);
+        size = static_cast<std::size_t>(status.st_size);
+    }
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+        out << std::string(size, '\0');
+    }
+    PersistentCircularBuffer<Event> buffer(file.path, 4);
+    EXPECT_TRUE(buffer.empty());
+    buffer.push_back(Event{1, 0});
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include <CXXCircularBuffer/QuantileWindow.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    template <typename T>
+    T nearest_rank(std::vector<T> values, double q)
+    {
+        std::sort(values.begin(), values.end());
+        const double position = std::ceil(q * values.size());
+        const std::size_t rank = position < 1 ? 0 : static_cast<std::size_t>(position) - 1;
+        return values[std::min(rank, values.size() - 1)];
+    }
+}
+
+TEST(QuantileWindowTest, ExactQuantiles)
+{
+    QuantileWindow<std::uint32_t, 5> window;
+    for (std::uint32_t value : {50u, 10u, 40u, 20u, 30u})
+    {
+        window.push_back(value);
+    }
+
+    EXPECT_EQ(window.median(), 30u);
+    EXPECT_EQ(window.quantile(0.0), 10u);
+    EXPECT_EQ(window.quantile(1.0), 50u);
+    EXPECT_EQ(window.quantile(0.2), 10u);
+    EXPECT_EQ(window.quantile(0.21), 20u);
+    EXPECT_EQ(window.select(3), 40u);
+    EXPECT_EQ(window.rank(35u), 3u);
+
+    // Evicts 50, the maximum
+    window.push_back(5);
+    EXPECT_EQ(window.quantile(1.0), 40u);
+    EXPECT_EQ(window.quantile(0.0), 5u);
+
+    window.pop_front();
+    EXPECT_EQ(window.size(), 4u);
+    EXPECT_EQ(window.select(0), 5u);
+    EXPECT_EQ(window.select(3), 40u);
+}
+
+TEST(QuantileWindowTest, ExactMatchesSortingWithDuplicates)
+{
+    QuantileWindow<int, 64> window;
+    std::deque<int> reference;
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> values(0, 20);
+
+    for (int step = 0; step < 3000; ++step)
+    {
+        const int value = values(generator);
+        window.push_back(value);
+        reference.push_back(value);
+        if (reference.size() > 64)
+        {
+            reference.pop_front();
+        }
+        if (step % 7 == 0)
+        {
+            window.pop_front();
+            reference.pop_front();
+        }
+
+        ASSERT_EQ(window.size(), reference.size());
+        if (reference.empty())
+        {
+            continue;
+        }
+        const std::vector<int> samples(reference.begin(), reference.end());
+        for (double q : {0.0, 0.25, 0.5, 0.9, 0.99, 1.0})
+        {
+            ASSERT_EQ(window.quantile(q), nearest_rank(samples, q));
+        }
+    }
+}
+
+TEST(QuantileWindowTest, ExactWithNonTrivialType)
+{
+    QuantileWindow<std::string, 3> window;
+    window.push_back("pear");
+    window.push_back("apple");
+    window.push_back("fig");
+    window.push_back("kiwi");
+
+    EXPECT_EQ(window.quantile(0.0), "apple");
+    EXPECT_EQ(window.median(), "fig");
+    EXPECT_EQ(window.quantile(1.0), "kiwi");
+
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    window.push_back("plum");
+    EXPECT_EQ(window.median(), "plum");
+}
+
+TEST(QuantileWindowTest, ApproximateWithinRelativeError)
+{
+    QuantileWindow<std::uint32_t, 1000, QuantileMode::Approximate> window;
+    std::deque<std::uint32_t> reference;
+    std::mt19937 generator(11);
+    std::lognormal_distribution<double> latencies(8.0, 1.5);
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        const std::uint32_t value = static_cast<std::uint32_t>(latencies(generator));
+        window.push_back(value);
+        reference.push_back(value);
+        if (reference.size() > 1000)
+        {
+            reference.pop_front();
+        }
+    }
+
+    const std::vector<std::uint32_t> samples(reference.begin(), reference.end());
+    for (double q : {0.01, 0.5, 0.9, 0.99, 0.999})
+    {
+        const double exact = nearest_rank(samples, q);
+        const double approximate = window.quantile(q);
+        // Precision 7 buckets are at most 1/64 of their value wide
+        EXPECT_NEAR(approximate, exact, exact / 64.0 + 1.0) << "q = " << q;
+    }
+}
+
+TEST(QuantileWindowTest, ApproximateSmallValuesAreExact)
+{
+    QuantileWindow<std::uint16_t, 4, QuantileMode::Approximate> window;
+    window.push_back(3);
+    window.push_back(100);
+    window.push_back(7);
+    window.push_back(1);
+    window.push_back(50); // Evicts 3
+
+    EXPECT_EQ(window.quantile(0.0), 1);
+    EXPECT_EQ(window.median(), 7);
+    EXPECT_EQ(window.quantile(1.0), 100);
+
+    window.pop_front();
+    window.pop_front();
+    EXPECT_EQ(window.quantile(0.0), 1);
+    EXPECT_EQ(window.quantile(1.0), 50);
+}
@@ -0,0 +1,189 @@
+#include <CXXCircularBuffer/CircularBuffer.hpp>
+#include <CXXCircularBuffer/DynamicCircularBuffer.hpp>
+#include <CXXCircularBuffer/Reductions.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // Deterministic samples with both signs
+    template <typename T>
+    T sample(int i)
+    {
+        return static_cast<T>((i * 37) % 101 - 50) / static_cast<T>(4);
+    }
+
+    template <typename Buffer>
+    std::vector<double> as_doubles(const Buffer &buffer)
+    {
+        return std::vector<double>(buffer.begin(), buffer.end());
+    }
+}
+
+TEST(ReductionsTest, FloatWindowAcrossWrap)
+{
+    CircularBuffer<float, 1000> buffer;
+    // Leaves the window wrapped with segments of odd lengths
+    for (int i = 0; i < 1357; ++i)
+    {
+        buffer.push_back(sample<float>(i));
+    }
+    ASSERT_FALSE(buffer.array_two().empty());
+
+    const std::vector<double> values = as_doubles(buffer);
+    double expected_sum = 0;
+    for (double value : values)
+    {
+        expected_sum += value;
+    }
+    const double expected_mean = expected_sum / values.size();
+    double expected_variance = 0;
+    for (double value : values)
+    {
+        expected_variance += (value - expected_mean) * (value - expected_mean);
+    }
+    expected_variance /= values.size();
+
+    EXPECT_NEAR(sum(buffer), expected_sum, 1e-2);
+    EXPECT_NEAR(mean(buffer), expected_mean, 1e-4);
+    EXPECT_NEAR(variance(buffer), expected_variance, 1e-2);
+    EXPECT_EQ(minimum(buffer), static_cast<float>(*std::min_element(values.begin(), values.end())));
+    EXPECT_EQ(maximum(buffer), static_cast<float>(*std::max_element(values.begin(), values.end())));
+}
+
+TEST(ReductionsTest, DotProductPairsOldestWithFirstCoefficient)
+{
+    CircularBuffer<double, 37> buffer;
+    for (int i = 0; i < 50; ++i)
+    {
+        buffer.push_back(sample<double>(i));
+    }
+
+    std::vector<double> kernel(37);
+    for (std::size_t i = 0; i < kernel.size(); ++i)
+    {
+        kernel[i] = 1.0 / static_cast<double>(i + 1);
+    }
+
+    double expected = 0;
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        expected += buffer[i] * kernel[i];
+    }
+    EXPECT_NEAR(dot(buffer, kernel), expected, 1e-9);
+}
+
+TEST(ReductionsTest, IntegralElements)
+{
+    CircularBuffer<int, 5> buffer;
+    for (int i = 1; i <= 7; ++i)
+    {
+        buffer.push_back(i);
+    }
+
+    // Window is 3 4 5 6 7
+    EXPECT_EQ(sum(buffer), 25);
+    EXPECT_EQ(minimum(buffer), 3);
+    EXPECT_EQ(maximum(buffer), 7);
+    EXPECT_DOUBLE_EQ(mean(buffer), 5.0);
+    EXPECT_DOUBLE_EQ(variance(buffer), 2.0);
+}
+
+TEST(ReductionsTest, IntegralSumsDoNotWrap)
+{
+    // Totals far beyond the range of each element type
+    CircularBuffer<std::uint8_t, 64> bytes;
+    for (int i = 0; i < 64; ++i)
+    {
+        bytes.push_back(200);
+    }
+    EXPECT_EQ(sum(bytes), 64u * 200u);
+    EXPECT_DOUBLE_EQ(mean(bytes), 200.0);
+    EXPECT_DOUBLE_EQ(variance(bytes), 0.0);
+
+    CircularBuffer<std::int16_t, 100> shorts;
+    for (int i = 0; i < 150; ++i)
+    {
+        shorts.push_back(static_cast<std::int16_t>(i % 2 == 0 ? -30000 : -20000));
+    }
+    EXPECT_EQ(sum(shorts), -2500000);
+    EXPECT_DOUBLE_EQ(mean(shorts), -25000.0);
+    EXPECT_DOUBLE_EQ(variance(shorts), 25000000.0);
+
+    DynamicCircularBuffer<int> ints(65536);
+    for (int i = 0; i < 65536; ++i)
+    {
+        ints.push_back(100000);
+    }
+    EXPECT_EQ(sum(ints), std::int64_t(65536) * 100000);
+    EXPECT_DOUBLE_EQ(mean(ints), 100000.0);
+
+    const std::vector<int> weights(65536, 100000);
+    EXPECT_EQ(dot(ints, Span<const int>(weights)), std::int64_t(65536) * 100000 * 100000);
+}
+
+TEST(ReductionsTest, WorksOnDynamicBuffer)
+{
+    DynamicCircularBuffer<float> buffer(3);
+    buffer.push_back(1.0f);
+    buffer.push_back(2.0f);
+    buffer.push_back(3.0f);
+    buffer.push_back(4.0f);
+
+    EXPECT_FLOAT_EQ(sum(buffer), 9.0f);
+    EXPECT_FLOAT_EQ(mean(buffer), 3.0f);
+    EXPECT_FLOAT_EQ(minimum(buffer), 2.0f);
+    EXPECT_FLOAT_EQ(maximum(buffer), 4.0f);
+}
+
+TEST(ReductionsTest, EmptyWindowSumIsZero)
+{
+    CircularBuffer<float, 8> buffer;
+    EXPECT_EQ(sum(buffer), 0.0f);
+}
+
+#if defined(CXXCIRCULARBUFFER_X86_SIMD)
+TEST(ReductionsTest, SimdKernelsMatchScalar)
+{
+    std::vector<float> floats(1031);
+    std::vector<double> doubles(1031);
+    for (std::size_t i = 0; i < floats.size(); ++i)
+    {
+        floats[i] = sample<float>(static_cast<int>(i));
+        doubles[i] = sample<double>(static_cast<int>(i));
+    }
+
+    typedef detail::ScalarKernels<float> FloatScalar;
+    typedef detail::ScalarKernels<double> DoubleScalar;
+
+    // Every length exercises a different mix of vector body and scalar tail
+    for (std::size_t n = 1; n < 70; ++n)
+    {
+        EXPECT_NEAR(detail::sum_sse(floats.data(), n), FloatScalar::sum(floats.data(), n), 1e-3);
+        EXPECT_EQ(detail::minimum_sse(floats.data(), n), FloatScalar::minimum(floats.data(), n));
+        EXPECT_EQ(detail::maximum_sse(floats.data(), n), FloatScalar::maximum(floats.data(), n));
+        EXPECT_NEAR(detail::dot_sse(floats.data(), floats.data(), n), FloatScalar::dot(floats.data(), floats.data(), n), 1e-2);
+        EXPECT_NEAR(detail::sum_sse(doubles.data(), n), DoubleScalar::sum(doubles.data(), n), 1e-9);
+        EXPECT_NEAR(detail::dot_sse(doubles.data(), doubles.data(), n), DoubleScalar::dot(doubles.data(), doubles.data(), n), 1e-9);
+
+        if (detail::cpu_has_avx2())
+        {
+            EXPECT_NEAR(detail::sum_avx2(floats.data(), n), FloatScalar::sum(floats.data(), n), 1e-3);
+            EXPECT_EQ(detail::minimum_avx2(floats.data(), n), FloatScalar::minimum(floats.data(), n));
+            EXPECT_EQ(detail::maximum_avx2(floats.data(), n), FloatScalar::maximum(floats.data(), n));
+            EXPECT_NEAR(detail::dot_avx2(floats.data(), floats.data(), n), FloatScalar::dot(floats.data(), floats.data(), n), 1e-2);
+            EXPECT_NEAR(detail::squared_deviation_avx2(floats.data(), n, 0.5f),
+                        FloatScalar::squared_deviation(floats.data(), n, 0.5f), 1e-2);
+            EXPECT_NEAR(detail::sum_avx2(doubles.data(), n), DoubleScalar::sum(doubles.data(), n), 1e-9);
+            EXPECT_NEAR(detail::squared_deviation_avx2(doubles.data(), n, 0.5),
+                        DoubleScalar::squared_deviation(doubles.data(), n, 0.5), 1e-9);
+        }
+    }
+}
+#endif
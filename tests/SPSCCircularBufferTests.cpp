@@ -0,0 +1,231 @@
+#include <CXXCircularBuffer/SPSCCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+using namespace CXXCircularBuffer;
+
+TEST(SPSCCircularBufferTest, PushAndPop)
+{
+    SPSCCircularBuffer<int, 3> buffer;
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), 3);
+
+    EXPECT_TRUE(buffer.try_push(1));
+    EXPECT_TRUE(buffer.try_push(2));
+    EXPECT_TRUE(buffer.try_push(3));
+    EXPECT_EQ(buffer.size(), 3);
+
+    // The buffer is full, pushing must fail instead of overwriting
+    EXPECT_FALSE(buffer.try_push(4));
+
+    int value = 0;
+    EXPECT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(value, 3);
+
+    // Popping from an empty buffer must fail and leave the value untouched
+    EXPECT_FALSE(buffer.try_pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCCircularBufferTest, WrapAround)
+{
+    SPSCCircularBuffer<int, 4> buffer;
+
+    int value = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(buffer.try_push(i));
+        EXPECT_TRUE(buffer.try_push(i + 100));
+        EXPECT_TRUE(buffer.try_pop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(buffer.try_pop(value));
+        EXPECT_EQ(value, i + 100);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCCircularBufferTest, FrontAndPopFront)
+{
+    SPSCCircularBuffer<int, 2> buffer;
+
+    EXPECT_EQ(buffer.front(), nullptr);
+
+    buffer.try_push(7);
+    ASSERT_NE(buffer.front(), nullptr);
+    EXPECT_EQ(*buffer.front(), 7);
+
+    buffer.pop_front();
+    EXPECT_EQ(buffer.front(), nullptr);
+}
+
+TEST(SPSCCircularBufferTest, MoveOnlyType)
+{
+    SPSCCircularBuffer<std::unique_ptr<int>, 2> buffer;
+
+    EXPECT_TRUE(buffer.try_push(std::make_unique<int>(5)));
+    EXPECT_TRUE(buffer.try_emplace(new int(6)));
+
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(*value, 5);
+    EXPECT_TRUE(buffer.try_pop(value));
+    EXPECT_EQ(*value, 6);
+}
+
+TEST(SPSCCircularBufferTest, DestroysRemainingElements)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        SPSCCircularBuffer<std::shared_ptr<int>, 4> buffer;
+        buffer.try_push(counter);
+        buffer.try_push(counter);
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SPSCCircularBufferTest, ReserveCommitPeekConsume)
+{
+    SPSCCircularBuffer<int, 4> buffer;
+    EXPECT_TRUE(buffer.try_push(1));
+    EXPECT_TRUE(buffer.try_push(2));
+    int value = 0;
+    EXPECT_TRUE(buffer.try_pop(value));
+
+    // Never overwrites: only the three free slots are handed out
+    Segments<int> slots = buffer.reserve(5);
+    ASSERT_EQ(slots.size(), 3);
+    EXPECT_EQ(slots.one.size(), 3);
+    slots[0] = 3;
+    slots[1] = 4;
+    EXPECT_TRUE(buffer.peek(4).size() == 1);
+    buffer.commit(2);
+    EXPECT_EQ(buffer.size(), 3);
+
+    Segments<int> view = buffer.peek(4);
+    ASSERT_EQ(view.size(), 3);
+    EXPECT_EQ(view[0], 2);
+    EXPECT_EQ(view[2], 4);
+    buffer.consume(2);
+    EXPECT_EQ(*buffer.front(), 4);
+
+    // Wraps around the end of the storage
+    slots = buffer.reserve(3);
+    ASSERT_EQ(slots.size(), 3);
+    EXPECT_EQ(slots.two.size(), 2);
+    buffer.commit(3);
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_TRUE(buffer.reserve(1).empty());
+}
+
+TEST(SPSCCircularBufferTest, ReserveAndPeekAcrossThreads)
+{
+    constexpr int count = 100000;
+    SPSCCircularBuffer<int, 64> buffer;
+
+    std::thread producer([&buffer]()
+                         {
+        int next = 0;
+        while (next < count)
+        {
+            Segments<int> slots = buffer.reserve(static_cast<std::size_t>(count - next));
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+                slots[i] = next + static_cast<int>(i);
+            }
+            buffer.commit(slots.size());
+            next += static_cast<int>(slots.size());
+            if (slots.empty())
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    int expected = 0;
+    while (expected < count)
+    {
+        Segments<int> view = buffer.peek(16);
+        for (std::size_t i = 0; i < view.size(); ++i)
+        {
+            ASSERT_EQ(view[i], expected);
+            ++expected;
+        }
+        buffer.consume(view.size());
+        if (view.empty())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCCircularBufferTest, Statistics)
+{
+    SPSCCircularBuffer<int, 3, true> buffer;
+    EXPECT_TRUE(buffer.try_push(1));
+    EXPECT_TRUE(buffer.try_push(2));
+    EXPECT_TRUE(buffer.try_push(3));
+    EXPECT_FALSE(buffer.try_push(4));
+    EXPECT_FALSE(buffer.try_push(4));
+
+    int item = 0;
+    EXPECT_TRUE(buffer.try_pop(item));
+    buffer.consume(buffer.peek(1).size());
+
+    BufferStatistics statistics = buffer.statistics();
+    EXPECT_EQ(statistics.pushes, 3u);
+    EXPECT_EQ(statistics.pops, 2u);
+    EXPECT_EQ(statistics.rejections, 2u);
+    EXPECT_EQ(statistics.high_water_mark, 3u);
+    // Full since the first rejected push
+    EXPECT_GT(statistics.time_full.count(), 0);
+
+    EXPECT_TRUE(buffer.try_push(4));
+    const auto time_full = buffer.statistics().time_full;
+    EXPECT_EQ(buffer.statistics().time_full, time_full);
+}
+
+TEST(SPSCCircularBufferTest, ProducerConsumerThreads)
+{
+    constexpr int count = 200000;
+    SPSCCircularBuffer<int, 64> buffer;
+
+    std::thread producer([&buffer]()
+                         {
+        for (int i = 0; i < count; ++i)
+        {
+            while (!buffer.try_push(i))
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    // Elements must arrive complete and in order
+    int expected = 0;
+    int value = 0;
+    while (expected < count)
+    {
+        if (buffer.try_pop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
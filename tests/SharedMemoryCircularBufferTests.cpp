@@ -0,0 +1,179 @@
+#include <CXXCircularBuffer/SharedMemoryCircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    struct Quote
+    {
+        std::uint64_t sequence;
+        double price;
+    };
+
+    std::string unique_name(const char *name)
+    {
+        return std::string("/cxxcircularbuffer_") + name + "_" + std::to_string(::getpid());
+    }
+}
+
+TEST(SharedMemoryCircularBufferTest, CreateAndAttach)
+{
+    const std::string name = unique_name("attach");
+    SharedMemoryCircularBuffer<Quote> producer = SharedMemoryCircularBuffer<Quote>::create(name, 3);
+    SharedMemoryCircularBuffer<Quote> consumer = SharedMemoryCircularBuffer<Quote>::attach(name);
+    EXPECT_EQ(consumer.capacity(), 3);
+
+    // The two mappings live at different addresses and share the content
+    EXPECT_TRUE(producer.try_push(Quote{1, 10.5}));
+    EXPECT_TRUE(producer.try_push(Quote{2, 11.0}));
+    EXPECT_EQ(consumer.size(), 2);
+
+    Quote quote{};
+    EXPECT_TRUE(consumer.try_pop(quote));
+    EXPECT_EQ(quote.sequence, 1u);
+    EXPECT_EQ(quote.price, 10.5);
+
+    // Bulk writes stop at the free space and wrap around the end
+    std::vector<Quote> batch = {{3, 0}, {4, 0}, {5, 0}};
+    EXPECT_EQ(producer.write(batch), 2);
+    EXPECT_FALSE(producer.try_push(Quote{5, 0}));
+
+    std::vector<Quote> out(5);
+    EXPECT_EQ(consumer.read(out), 3);
+    EXPECT_EQ(out[0].sequence, 2u);
+    EXPECT_EQ(out[2].sequence, 4u);
+    EXPECT_TRUE(consumer.empty());
+    EXPECT_FALSE(consumer.try_pop(quote));
+}
+
+TEST(SharedMemoryCircularBufferTest, RejectsUnknownObjects)
+{
+    const std::string name = unique_name("reject");
+    EXPECT_THROW(SharedMemoryCircularBuffer<Quote>::attach(name), std::system_error);
+
+    SharedMemoryCircularBuffer<Quote> ring = SharedMemoryCircularBuffer<Quote>::create(name, 4);
+    EXPECT_THROW(SharedMemoryCircularBuffer<Quote>::create(name, 4), std::system_error);
+    EXPECT_THROW(SharedMemoryCircularBuffer<std::uint32_t>::attach(name), std::runtime_error);
+}
+
+TEST(SharedMemoryCircularBufferTest, RejectsOverflowingSizes)
+{
+    const std::string name = unique_name("overflow");
+    EXPECT_THROW(SharedMemoryCircularBuffer<Quote>::create(name, std::numeric_limits<std::size_t>::max() / 2),
+                 std::length_error);
+
+    // A header whose capacity (at offset 16) times sizeof(T) wraps around to
+    // fit the object
+    SharedMemoryCircularBuffer<Quote> ring = SharedMemoryCircularBuffer<Quote>::create(name, 4);
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_NE(fd, -1);
+    void *region = ::mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(region, MAP_FAILED);
+    const std::uint64_t capacity = std::uint64_t(1) << 60;
+    std::memcpy(static_cast<char *>(region) + 16, &capacity, sizeof(capacity));
+    ::munmap(region, 64);
+    EXPECT_THROW(SharedMemoryCircularBuffer<Quote>::attach(name), std::runtime_error);
+}
+
+TEST(SharedMemoryCircularBufferTest, IgnoresCorruptCounters)
+{
+    const std::string name = unique_name("counters");
+    SharedMemoryCircularBuffer<Quote> producer = SharedMemoryCircularBuffer<Quote>::create(name, 4);
+    SharedMemoryCircularBuffer<Quote> consumer = SharedMemoryCircularBuffer<Quote>::attach(name);
+    EXPECT_TRUE(producer.try_push(Quote{1, 1.0}));
+
+    // head and tail sit on the second and third cache lines of the header
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_NE(fd, -1);
+    void *region = ::mmap(nullptr, 192, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(region, MAP_FAILED);
+    char *header = static_cast<char *>(region);
+    const std::uint64_t head = 1000000;
+    const std::uint64_t tail = 5;
+    std::memcpy(header + 64, &head, sizeof(head));
+    std::memcpy(header + 128, &tail, sizeof(tail));
+
+    // A distance far beyond the capacity reads as empty and as full
+    std::vector<Quote> out(1000);
+    EXPECT_EQ(consumer.read(out), 0);
+    EXPECT_EQ(consumer.size(), 0);
+    std::vector<Quote> batch(1000, Quote{2, 2.0});
+    EXPECT_EQ(producer.write(batch), 0);
+
+    // So does a tail ahead of head, whose distance wraps around
+    std::memcpy(header + 64, &tail, sizeof(tail));
+    std::memcpy(header + 128, &head, sizeof(head));
+    EXPECT_EQ(consumer.read(out), 0);
+    EXPECT_EQ(producer.write(batch), 0);
+    ::munmap(region, 192);
+}
+
+TEST(SharedMemoryCircularBufferTest, ProducerAndConsumerProcesses)
+{
+    constexpr std::uint64_t count = 100000;
+    const std::string name = unique_name("processes");
+    SharedMemoryCircularBuffer<Quote> consumer = SharedMemoryCircularBuffer<Quote>::create(name, 64);
+
+    const pid_t child = ::fork();
+    ASSERT_NE(child, -1);
+    if (child == 0)
+    {
+        int status = 0;
+        try
+        {
+            SharedMemoryCircularBuffer<Quote> producer = SharedMemoryCircularBuffer<Quote>::attach(name);
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                while (!producer.try_push(Quote{i, static_cast<double>(i) / 2}))
+                {
+                    ::sched_yield();
+                }
+            }
+        }
+        catch (...)
+        {
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    std::uint64_t expected = 0;
+    Quote quote{};
+    while (expected < count)
+    {
+        if (consumer.try_pop(quote))
+        {
+            ASSERT_EQ(quote.sequence, expected);
+            ASSERT_EQ(quote.price, static_cast<double>(expected) / 2);
+            ++expected;
+        }
+        else
+        {
+            ::sched_yield();
+        }
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include <CXXCircularBuffer/SlidingWindow.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+using namespace CXXCircularBuffer;
+
+TEST(SlidingWindowTest, AggregatesFollowOverwrites)
+{
+    SlidingWindow<int, 3> window;
+
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.sum(), 0.0);
+    EXPECT_EQ(window.variance(), 0.0);
+
+    window.push_back(4);
+    window.push_back(1);
+    window.push_back(7);
+    EXPECT_DOUBLE_EQ(window.sum(), 12.0);
+    EXPECT_DOUBLE_EQ(window.mean(), 4.0);
+    EXPECT_DOUBLE_EQ(window.variance(), 6.0);
+    EXPECT_DOUBLE_EQ(window.sample_variance(), 9.0);
+    EXPECT_EQ(window.minimum(), 1);
+    EXPECT_EQ(window.maximum(), 7);
+
+    // Evicts 4
+    window.push_back(2);
+    EXPECT_DOUBLE_EQ(window.sum(), 10.0);
+    EXPECT_EQ(window.minimum(), 1);
+    EXPECT_EQ(window.maximum(), 7);
+
+    // Evicts 1, the current minimum
+    window.push_back(5);
+    EXPECT_EQ(window.minimum(), 2);
+
+    // Evicts 7, the current maximum
+    window.pop_front();
+    EXPECT_EQ(window.size(), 2);
+    EXPECT_EQ(window.maximum(), 5);
+    EXPECT_DOUBLE_EQ(window.mean(), 3.5);
+}
+
+TEST(SlidingWindowTest, DuplicateExtremes)
+{
+    SlidingWindow<int, 4> window;
+    window.push_back(3);
+    window.push_back(3);
+    window.push_back(3);
+
+    window.pop_front();
+    EXPECT_EQ(window.minimum(), 3);
+    EXPECT_EQ(window.maximum(), 3);
+    window.pop_front();
+    EXPECT_EQ(window.minimum(), 3);
+    EXPECT_DOUBLE_EQ(window.variance(), 0.0);
+}
+
+TEST(SlidingWindowTest, ClearAndReuse)
+{
+    SlidingWindow<double, 3> window;
+    window.push_back(1.5);
+    window.push_back(-2.5);
+    window.clear();
+
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.sum(), 0.0);
+
+    window.push_back(8.0);
+    EXPECT_EQ(window.minimum(), 8.0);
+    EXPECT_EQ(window.maximum(), 8.0);
+    EXPECT_DOUBLE_EQ(window.mean(), 8.0);
+}
+
+TEST(SlidingWindowTest, MatchesRecomputation)
+{
+    SlidingWindow<double, 16> window;
+    std::deque<double> reference;
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> values(-100.0, 100.0);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        if (action(generator) == 0)
+        {
+            window.pop_front();
+            if (!reference.empty())
+            {
+                reference.pop_front();
+            }
+        }
+        else
+        {
+            const double value = values(generator);
+            window.push_back(value);
+            reference.push_back(value);
+            if (reference.size() > 16)
+            {
+                reference.pop_front();
+            }
+        }
+
+        ASSERT_EQ(window.size(), reference.size());
+        if (reference.empty())
+        {
+            continue;
+        }
+
+        double total = 0;
+        for (double value : reference)
+        {
+            total += value;
+        }
+        const double average = total / reference.size();
+        double squares = 0;
+        for (double value : reference)
+        {
+            squares += (value - average) * (value - average);
+        }
+
+        ASSERT_NEAR(window.sum(), total, 1e-7);
+        ASSERT_NEAR(window.mean(), average, 1e-7);
+        ASSERT_NEAR(window.variance(), squares / reference.size(), 1e-6);
+        ASSERT_EQ(window.minimum(), *std::min_element(reference.begin(), reference.end()));
+        ASSERT_EQ(window.maximum(), *std::max_element(reference.begin(), reference.end()));
+    }
+}
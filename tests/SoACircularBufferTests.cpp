@@ -0,0 +1,100 @@
+#include <CXXCircularBuffer/SoACircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    // timestamp, price, quantity, flags
+    typedef SoACircularBuffer<4, std::int64_t, double, std::uint32_t, std::uint8_t> Ticks;
+}
+
+TEST(SoACircularBufferTest, PushPopAndRecords)
+{
+    Ticks ticks;
+    EXPECT_TRUE(ticks.empty());
+    EXPECT_EQ(ticks.capacity(), 4);
+
+    ticks.push_back(100, 10.5, 3, 1);
+    ticks.push_back(101, 10.75, 5, 0);
+    EXPECT_EQ(ticks.size(), 2);
+    EXPECT_EQ(ticks.front(), Ticks::value_type(100, 10.5, 3, 1));
+    EXPECT_EQ(ticks.back(), Ticks::value_type(101, 10.75, 5, 0));
+    EXPECT_EQ(ticks.get<1>(1), 10.75);
+
+    ticks.get<2>(0) = 7;
+    EXPECT_EQ(std::get<2>(ticks[0]), 7u);
+
+    ticks.pop_front();
+    EXPECT_EQ(ticks.size(), 1);
+    EXPECT_EQ(ticks.get<0>(0), 101);
+
+    ticks.clear();
+    EXPECT_TRUE(ticks.empty());
+    ticks.pop_front();
+    EXPECT_TRUE(ticks.empty());
+}
+
+TEST(SoACircularBufferTest, OverwriteKeepsFieldsAligned)
+{
+    Ticks ticks;
+    for (std::int64_t i = 0; i < 6; ++i)
+    {
+        ticks.push_back(i, i * 0.5, static_cast<std::uint32_t>(i * 10), static_cast<std::uint8_t>(i % 2));
+    }
+    EXPECT_TRUE(ticks.full());
+    for (std::size_t i = 0; i < ticks.size(); ++i)
+    {
+        const std::int64_t timestamp = static_cast<std::int64_t>(i) + 2;
+        EXPECT_EQ(ticks[i], Ticks::value_type(timestamp, timestamp * 0.5, timestamp * 10, timestamp % 2));
+    }
+
+    ticks.pop_front_n(3);
+    EXPECT_EQ(ticks.size(), 1);
+    EXPECT_EQ(ticks.get<0>(0), 5);
+    ticks.pop_front_n(10);
+    EXPECT_TRUE(ticks.empty());
+}
+
+TEST(SoACircularBufferTest, FieldViews)
+{
+    Ticks ticks;
+    for (std::int64_t i = 0; i < 7; ++i)
+    {
+        ticks.push_back(i, static_cast<double>(i), 1, 0);
+    }
+
+    // Records 3..6 occupy slots 3, 0, 1, 2
+    Ticks::FieldView<1> prices = ticks.field<1>();
+    EXPECT_EQ(prices.size(), 4);
+    EXPECT_EQ(prices.segments().one.size(), 1);
+    EXPECT_EQ(prices.segments().two.size(), 3);
+    EXPECT_EQ(prices[0], 3.0);
+    EXPECT_EQ(prices[3], 6.0);
+
+    const std::vector<double> scanned(prices.begin(), prices.end());
+    EXPECT_EQ(scanned, (std::vector<double>{3.0, 4.0, 5.0, 6.0}));
+    EXPECT_EQ(std::accumulate(prices.begin(), prices.end(), 0.0), 18.0);
+    EXPECT_EQ(prices.end() - prices.begin(), 4);
+
+    // Mutable segments update a single field in place
+    Segments<std::uint32_t> quantities = ticks.segments<2>();
+    for (std::uint32_t &quantity : quantities.one)
+    {
+        quantity = 9;
+    }
+    for (std::uint32_t &quantity : quantities.two)
+    {
+        quantity = 8;
+    }
+    EXPECT_EQ(ticks.get<2>(0), 9u);
+    EXPECT_EQ(ticks.get<2>(3), 8u);
+
+    const Ticks copy = ticks;
+    EXPECT_EQ(copy.back(), Ticks::value_type(6, 6.0, 8, 0));
+    EXPECT_TRUE(copy.field<0>().begin() != ticks.field<0>().begin());
+}
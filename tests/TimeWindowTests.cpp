@@ -0,0 +1,129 @@
+#include <CXXCircularBuffer/TimeWindow.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace CXXCircularBuffer;
+
+namespace
+{
+    typedef TimeWindow<int, 8> Window;
+
+    Window::time_point at(int milliseconds)
+    {
+        return Window::time_point(std::chrono::milliseconds(milliseconds));
+    }
+
+    std::vector<int> flatten(const Segments<const int> &segments)
+    {
+        std::vector<int> values(segments.one.begin(), segments.one.end());
+        values.insert(values.end(), segments.two.begin(), segments.two.end());
+        return values;
+    }
+}
+
+TEST(TimeWindowTest, EvictsByAgeOnPush)
+{
+    Window window(std::chrono::milliseconds(100));
+    EXPECT_EQ(window.window(), std::chrono::milliseconds(100));
+
+    window.push_back(at(0), 1);
+    window.push_back(at(50), 2);
+    window.push_back(at(100), 3);
+    EXPECT_EQ(window.size(), 3);
+
+    // 0 is now older than 101 - 100
+    window.push_back(at(101), 4);
+    EXPECT_EQ(window.size(), 3);
+    EXPECT_EQ(window.front(), 2);
+    EXPECT_EQ(window.timestamp(0), at(50));
+    EXPECT_EQ(window.back(), 4);
+
+    // A sample exactly window() old is kept
+    EXPECT_EQ(window.expire(at(200)), 1);
+    EXPECT_EQ(window.front(), 3);
+    EXPECT_EQ(window.expire(at(201)), 1);
+    EXPECT_EQ(window.front(), 4);
+    EXPECT_EQ(window.expire(at(500)), 1);
+    EXPECT_TRUE(window.empty());
+}
+
+TEST(TimeWindowTest, CapacityEvictsOldest)
+{
+    Window window(std::chrono::seconds(10));
+    for (int i = 0; i < 11; ++i)
+    {
+        window.push_back(at(i), i);
+    }
+    EXPECT_TRUE(window.full());
+    EXPECT_EQ(window.front(), 3);
+    EXPECT_EQ(window[7], 10);
+}
+
+TEST(TimeWindowTest, BinarySearchAcrossWrap)
+{
+    Window window(std::chrono::seconds(10));
+    // Samples every 10ms, with duplicates at 60ms; the storage wraps after 8
+    const std::vector<int> stamps = {0, 10, 20, 30, 40, 50, 60, 60, 60, 70, 80};
+    for (std::size_t i = 0; i < stamps.size(); ++i)
+    {
+        window.push_back(at(stamps[i]), static_cast<int>(i));
+    }
+    ASSERT_FALSE(window.timestamps().two.empty());
+
+    // Holding 30, 40, 50, 60, 60, 60, 70, 80
+    EXPECT_EQ(window.lower_bound(at(0)), 0);
+    EXPECT_EQ(window.lower_bound(at(35)), 1);
+    EXPECT_EQ(window.lower_bound(at(60)), 3);
+    EXPECT_EQ(window.upper_bound(at(60)), 6);
+    EXPECT_EQ(window.lower_bound(at(80)), 7);
+    EXPECT_EQ(window.lower_bound(at(81)), 8);
+
+    for (int t = 0; t <= 90; ++t)
+    {
+        std::size_t expected = 0;
+        while (expected < window.size() && window.timestamp(expected) < at(t))
+        {
+            ++expected;
+        }
+        ASSERT_EQ(window.lower_bound(at(t)), expected) << t;
+    }
+}
+
+TEST(TimeWindowTest, RangeQueriesReturnSegments)
+{
+    Window window(std::chrono::seconds(10));
+    for (int i = 0; i < 12; ++i)
+    {
+        window.push_back(at(i * 10), i);
+    }
+
+    // Holding 40..110; values 4..11
+    EXPECT_EQ(flatten(window.values()), (std::vector<int>{4, 5, 6, 7, 8, 9, 10, 11}));
+    EXPECT_EQ(flatten(window.range(at(55), at(95))), (std::vector<int>{6, 7, 8, 9}));
+    EXPECT_EQ(flatten(window.range(at(0), at(45))), (std::vector<int>{4}));
+    EXPECT_EQ(flatten(window.range(at(100), at(1000))), (std::vector<int>{10, 11}));
+    EXPECT_TRUE(window.range(at(90), at(60)).empty());
+    EXPECT_TRUE(window.range(at(200), at(300)).empty());
+
+    // A range straddling the wrap is split in two
+    const Segments<const int> straddling = window.range(at(60), at(100));
+    EXPECT_FALSE(straddling.one.empty());
+    EXPECT_FALSE(straddling.two.empty());
+    EXPECT_EQ(straddling.size(), 4);
+}
+
+TEST(TimeWindowTest, ClockTimestamps)
+{
+    TimeWindow<double, 4> window(std::chrono::hours(1));
+    window.push_back(1.5);
+    window.push_back(2.5);
+    EXPECT_EQ(window.size(), 2);
+    EXPECT_EQ(window.expire(), 0);
+    EXPECT_LE(window.timestamp(0), window.timestamp(1));
+
+    window.set_window(std::chrono::nanoseconds(0));
+    window.expire(window.timestamp(1) + std::chrono::seconds(1));
+    EXPECT_TRUE(window.empty());
+}